@@ -3,8 +3,13 @@
 #include <vector>
 #include <random>
 #include <memory>
+#include <unordered_map>
+#include <limits>
+#include <utility>
 
 #include <Memory/Manager.hpp>
+#include <Memory/FlatTable.hpp>
+#include <Memory/NameHash.hpp>
 #include <Memory/Program.hpp>
 #include <Memory/VariableDescriptor.hpp>
 
@@ -100,11 +105,135 @@ void simple_benchmark_get_used_memory() {
     std::cout << "\n=== Бенчмарк завершен ===\n";
 }
 
+void benchmark_used_memory_strategies() {
+    std::cout << "=== Бенчмарк стратегий get_used_memory() ===\n";
+    
+    const std::vector<size_t> element_counts = {1000, 10000, 100000, 1000000, 10000000};
+    const std::vector<std::pair<UsedMemoryStrategy, const char*>> strategies = {
+        {UsedMemoryStrategy::Serial, "Serial"},
+        {UsedMemoryStrategy::ParallelStl, "ParallelStl"},
+        {UsedMemoryStrategy::Threads, "Threads"},
+        {UsedMemoryStrategy::Tbb, "Tbb"},
+        {UsedMemoryStrategy::Auto, "Auto"},
+    };
+    const int measured_runs = 5;
+    
+    size_t threshold = Program::calibrate_parallel_threshold();
+    if (threshold == std::numeric_limits<size_t>::max())
+        std::cout << "Калибровка порога: параллельный режим не выигрывает, Auto остается последовательным\n";
+    else
+        std::cout << "Калибровка порога: " << threshold << " элементов\n";
+    
+    const size_t total_memory = 1 << 26;
+    Manager<total_memory> manager;
+    Program* program = manager.add_program("strategies", "benchmark.cpp", total_memory);
+    if (!program) {
+        std::cerr << "Ошибка создания программы!\n";
+        return;
+    }
+    
+    // Elements are added to one program, so each count extends the previous one.
+    size_t allocated = 0;
+    size_t expected = 0;
+    for (size_t num_elements : element_counts) {
+        for (; allocated < num_elements; ++allocated) {
+            size_t element_size = 1 + allocated % 6;
+            if (!program->allocate_element<VariableDescriptor>("var_" + std::to_string(allocated), element_size)) {
+                std::cerr << "Ошибка выделения элемента " << allocated << "\n";
+                return;
+            }
+            expected += element_size;
+        }
+        std::cout << "\nКоличество элементов: " << num_elements << "\n";
+        
+        for (auto&& [strategy, title] : strategies) {
+            long long min_time_ns = std::numeric_limits<long long>::max();
+            for (int i = 0; i < measured_runs; ++i) {
+                auto start = std::chrono::high_resolution_clock::now();
+                size_t used = program->get_used_memory(strategy);
+                auto end = std::chrono::high_resolution_clock::now();
+                min_time_ns = std::min<long long>(min_time_ns, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+                if (used != expected)
+                    std::cout << "  Расхождение в " << title << "! Ожидалось: " << expected << ", получено: " << used << "\n";
+            }
+            std::cout << "  " << title << ": " << min_time_ns << " нс (" 
+                      << static_cast<double>(min_time_ns) / static_cast<double>(num_elements) << " нс/элемент)\n";
+        }
+    }
+    
+    std::cout << "\n=== Бенчмарк завершен ===\n";
+}
+
+template<typename F>
+double measure_ns_per_op(size_t ops, F&& f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / static_cast<double>(ops);
+}
+
+template<typename Table>
+void run_table_benchmark(const char* title, const std::vector<std::string>& keys, size_t memory_usage(const Table&)) {
+    Table table;
+    size_t checksum = 0;
+    
+    double insert_ns = measure_ns_per_op(keys.size(), [&]() {
+        for (size_t i = 0; i < keys.size(); ++i)
+            table.try_emplace(keys[i], i);
+    });
+    double lookup_ns = measure_ns_per_op(keys.size(), [&]() {
+        for (const auto& key : keys)
+            checksum += table.find(key)->second;
+    });
+    size_t memory = memory_usage(table);
+    double erase_ns = measure_ns_per_op(keys.size(), [&]() {
+        for (const auto& key : keys)
+            table.erase(key);
+    });
+    
+    std::cout << "  " << title << ":\n";
+    std::cout << "    Вставка: " << insert_ns << " нс/оп\n";
+    std::cout << "    Поиск:   " << lookup_ns << " нс/оп\n";
+    std::cout << "    Удаление: " << erase_ns << " нс/оп\n";
+    std::cout << "    Память:  " << memory << " байт (" << static_cast<double>(memory) / static_cast<double>(keys.size()) << " байт/элемент)\n";
+    if (checksum == 0 && keys.size() > 1) std::cout << "    Неверная контрольная сумма\n";
+}
+
+void benchmark_flat_table() {
+    std::cout << "=== Бенчмарк FlatTable против std::unordered_map ===\n";
+    
+    using FlatMap = NameMap<size_t>;
+    using StdMap = std::unordered_map<std::string, size_t>;
+    const std::vector<size_t> element_counts = {1000, 10000, 100000, 1000000};
+    
+    for (size_t num_elements : element_counts) {
+        std::cout << "\nКоличество элементов: " << num_elements << "\n";
+        
+        std::vector<std::string> keys;
+        keys.reserve(num_elements);
+        for (size_t i = 0; i < num_elements; ++i)
+            keys.push_back("var_" + std::to_string(i));
+        
+        run_table_benchmark<FlatMap>("FlatTable", keys, [](const FlatMap& table) -> size_t {
+            return table.get_memory_usage();
+        });
+        run_table_benchmark<StdMap>("std::unordered_map", keys, [](const StdMap& table) -> size_t {
+            // Node: next pointer, value and cached hash; plus the bucket array
+            size_t node = sizeof(void*) + sizeof(StdMap::value_type) + sizeof(size_t);
+            return table.size() * node + table.bucket_count() * sizeof(void*);
+        });
+    }
+    
+    std::cout << "\n=== Бенчмарк завершен ===\n";
+}
+
 int main() {
     std::cout << "Запуск простого бенчмарка для get_used_memory()\n";
     
     try {
         simple_benchmark_get_used_memory(); 
+        benchmark_used_memory_strategies();
+        benchmark_flat_table();
     }
     catch (const std::exception& e) {
         std::cerr << "Ошибка: " << e.what() << "\n";
@@ -0,0 +1,201 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Memory/Manager.hpp>
+#include <Memory/Program.hpp>
+#include <Memory/VariableDescriptor.hpp>
+#include <Memory/ArrayDescriptor.hpp>
+#include <Memory/ReferenceDescriptor.hpp>
+
+using namespace MemoryNameSpace;
+
+namespace {
+
+constexpr size_t CAPACITY = 1 << 26;
+using BenchManager = Manager<CAPACITY>;
+
+std::string element_name(size_t index) {
+    return "var_" + std::to_string(index);
+}
+
+/**
+ * @brief Allocates count variables of size bytes named var_0, var_1, ...
+ */
+void fill_program(Program* program, size_t count, size_t size) {
+    for (size_t i = 0; i < count; ++i)
+        program->allocate_element<VariableDescriptor>(element_name(i), size);
+}
+
+}
+
+// Every other block of a packed prefix is freed, so first fit walks past
+// `holes` free blocks that are too small before it reaches the tail.
+static void BM_BufferAllocateDestroy(benchmark::State& state) {
+    const size_t holes = static_cast<size_t>(state.range(0));
+    auto buffer = std::make_unique<Buffer<CAPACITY>>();
+    std::vector<size_t> offsets;
+    for (size_t i = 0; i < 2 * holes; ++i)
+        offsets.push_back(buffer->allocate_block(64));
+    for (size_t i = 0; i < offsets.size(); i += 2)
+        buffer->destroy_block(offsets[i], 64);
+
+    for (auto _ : state) {
+        size_t offset = buffer->allocate_block(128);
+        benchmark::DoNotOptimize(offset);
+        buffer->destroy_block(offset, 128);
+    }
+    state.counters["free_blocks"] = static_cast<double>(buffer->get_blocks().size());
+}
+BENCHMARK(BM_BufferAllocateDestroy)->Arg(0)->Arg(64)->Arg(1024)->Arg(16384);
+
+static void BM_AllocateDestroyElement(benchmark::State& state) {
+    BenchManager manager;
+    Program* program = manager.add_program("bench", "bench.cpp", CAPACITY);
+    fill_program(program, static_cast<size_t>(state.range(0)), 16);
+    const std::string name = "bench_element";
+
+    for (auto _ : state) {
+        auto* element = program->allocate_element<VariableDescriptor>(name, sizeof(long long));
+        benchmark::DoNotOptimize(element);
+        program->destroy_element(name);
+    }
+}
+BENCHMARK(BM_AllocateDestroyElement)->Arg(0)->Arg(1000)->Arg(100000);
+
+static void BM_VariableGetSet(benchmark::State& state) {
+    BenchManager manager;
+    Program* program = manager.add_program("bench", "bench.cpp", CAPACITY);
+    auto* variable = program->allocate_element<VariableDescriptor>("x", sizeof(long long));
+    long long value = 0;
+
+    for (auto _ : state) {
+        variable->set_value(value + 1);
+        variable->get_value(value);
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_VariableGetSet);
+
+static void BM_ArrayReadWriteRange(benchmark::State& state) {
+    const size_t length = static_cast<size_t>(state.range(0));
+    BenchManager manager;
+    Program* program = manager.add_program("bench", "bench.cpp", CAPACITY);
+    auto* array = program->allocate_element<ArrayDescriptor>("arr", length * sizeof(int), sizeof(int));
+    std::vector<int> values(length, 7);
+
+    for (auto _ : state) {
+        array->write_range<int>(0, values);
+        array->read_range<int>(0, values);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * 2 * length * sizeof(int)));
+}
+BENCHMARK(BM_ArrayReadWriteRange)->Arg(16)->Arg(1024)->Arg(65536);
+
+static void BM_ReferenceGetSet(benchmark::State& state) {
+    BenchManager manager;
+    Program* program = manager.add_program("bench", "bench.cpp", CAPACITY);
+    program->allocate_element<VariableDescriptor>("x", sizeof(long long));
+    ReferenceDescriptor* reference = program->make_reference("ref", "x");
+    long long value = 0;
+
+    for (auto _ : state) {
+        reference->set_value(value + 1);
+        reference->get_value(value);
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_ReferenceGetSet);
+
+// Each iteration appends an element at the tail and then frees the lowest
+// one, so every other element moves down into the hole.
+static void BM_DefragmentMemory(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    BenchManager manager;
+    Program* program = manager.add_program("bench", "bench.cpp", CAPACITY);
+    fill_program(program, count, 64);
+    size_t next = count;
+    size_t first = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        program->allocate_element<VariableDescriptor>(element_name(next++), 64);
+        program->destroy_element(element_name(first++));
+        state.ResumeTiming();
+        manager.defragment_memory();
+    }
+    const size_t moved = manager.get_stats().moved_bytes;
+    state.counters["moved_bytes"] = benchmark::Counter(static_cast<double>(moved), benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(static_cast<int64_t>(moved));
+}
+BENCHMARK(BM_DefragmentMemory)->Arg(1000)->Arg(100000);
+
+static void BM_Statistics(benchmark::State& state) {
+    const size_t programs = static_cast<size_t>(state.range(0));
+    BenchManager manager;
+    for (size_t i = 0; i < programs; ++i) {
+        Program* program = manager.add_program("prog_" + std::to_string(i), "bench.cpp", CAPACITY);
+        fill_program(program, 100, 16);
+    }
+
+    for (auto _ : state) {
+        auto statistics = manager.statistics();
+        benchmark::DoNotOptimize(statistics);
+    }
+}
+BENCHMARK(BM_Statistics)->Arg(1)->Arg(16)->Arg(256);
+
+static void BM_StatsSnapshot(benchmark::State& state) {
+    const size_t programs = static_cast<size_t>(state.range(0));
+    BenchManager manager;
+    for (size_t i = 0; i < programs; ++i) {
+        Program* program = manager.add_program("prog_" + std::to_string(i), "bench.cpp", CAPACITY);
+        fill_program(program, 100, 16);
+    }
+
+    for (auto _ : state) {
+        MemoryStats stats = manager.get_stats();
+        benchmark::DoNotOptimize(stats);
+    }
+}
+BENCHMARK(BM_StatsSnapshot)->Arg(1)->Arg(256);
+
+static void BM_DunglingReference(benchmark::State& state) {
+    const size_t dangling = static_cast<size_t>(state.range(0));
+    BenchManager manager;
+    Program* program = manager.add_program("bench", "bench.cpp", CAPACITY);
+    fill_program(program, dangling + 1000, 16);
+    for (size_t i = 0; i < dangling + 1000; ++i)
+        program->make_reference("ref_" + std::to_string(i), element_name(i));
+    for (size_t i = 0; i < dangling; ++i)
+        program->destroy_element(element_name(i));
+
+    for (auto _ : state) {
+        auto references = manager.dungling_reference();
+        benchmark::DoNotOptimize(references);
+    }
+}
+BENCHMARK(BM_DunglingReference)->Arg(0)->Arg(100)->Arg(10000);
+
+// Results are written as JSON unless another format is requested.
+int main(int argc, char** argv) {
+    std::vector<char*> args(argv, argv + argc);
+    bool has_format = false;
+    for (char* arg : args)
+        has_format = has_format || std::string_view(arg).starts_with("--benchmark_format");
+    static char json_format[] = "--benchmark_format=json";
+    if (!has_format)
+        args.insert(args.begin() + (args.empty() ? 0 : 1), json_format);
+
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data()))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
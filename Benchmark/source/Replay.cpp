@@ -0,0 +1,85 @@
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Memory/Manager.hpp>
+#include <Memory/SimulationBuffer.hpp>
+#include <Memory/Trace.hpp>
+
+using namespace MemoryNameSpace;
+
+namespace {
+
+constexpr size_t CAPACITY = 1 << 26;
+
+void print_latency(const char* title, const LatencySummary& latency) {
+    if (latency.count == 0) return;
+    std::cout << "  " << title << " (" << latency.count << "): p50 " << latency.p50
+              << " нс, p90 " << latency.p90 << " нс, p99 " << latency.p99
+              << " нс, макс. " << latency.max << " нс\n";
+}
+
+void print_result(const char* title, const ReplayResult& result) {
+    std::cout << "\n" << title << "\n";
+    std::cout << "  Событий: " << result.events << ", неудачных операций: " << result.failed << "\n";
+    std::cout << "  Пропускная способность: " << static_cast<size_t>(result.throughput) << " событий/с\n";
+    print_latency("Выделение", result.allocate);
+    print_latency("Освобождение", result.free);
+    print_latency("Дефрагментация", result.defragment);
+    std::cout << "  Пиковое использование: " << result.peak_used << " байт\n";
+    std::cout << "  Пиковая фрагментация: " << result.peak_fragmentation * 100.0 << "%\n";
+}
+
+}
+
+// Replays a trace file written by write_trace, or a synthetic workload
+// when no file is given.
+int main(int argc, char** argv) {
+    std::vector<TraceEvent> events;
+    if (argc > 1) {
+        std::ifstream in(argv[1], std::ios::binary);
+        if (!in) {
+            std::cerr << "Не удалось открыть трассу " << argv[1] << "\n";
+            return 1;
+        }
+        auto trace = read_trace(in);
+        if (!trace) {
+            std::cerr << "Некорректная трасса " << argv[1] << " (код " << static_cast<int>(trace.error()) << ")\n";
+            return 1;
+        }
+        events = std::move(*trace);
+        std::cout << "=== Воспроизведение трассы " << argv[1] << " ===\n";
+    } else {
+        TraceWorkload workload;
+        workload.allocations = 100000;
+        workload.mean_lifetime = 1000.0;
+        workload.programs = 4;
+        workload.defragment_every = 20000;
+        events = generate_trace(workload);
+        std::cout << "=== Воспроизведение синтетической трассы ===\n";
+        std::cout << "Выделений: " << workload.allocations << ", средний срок жизни: "
+                  << workload.mean_lifetime << " выделений\n";
+    }
+
+    auto buffer = std::make_unique<Buffer<CAPACITY>>();
+    print_result("Буфер:", replay_trace(events, *buffer));
+
+    Manager<CAPACITY> manager;
+    print_result("Менеджер:", replay_trace(events, manager));
+
+    // The same capacity without backing storage, under each allocator policy.
+    const std::pair<AllocatorPolicy, const char*> policies[] = {
+        {AllocatorPolicy::FirstFit, "Симуляция, first fit:"},
+        {AllocatorPolicy::BestFit, "Симуляция, best fit:"},
+        {AllocatorPolicy::WorstFit, "Симуляция, worst fit:"},
+    };
+    for (auto [policy, title] : policies) {
+        Manager<0> simulation(std::make_unique<SimulationBuffer>(CAPACITY, policy));
+        print_result(title, replay_trace(events, simulation));
+        std::cout << "  Перемещено при дефрагментации: " << simulation.get_stats().moved_bytes << " байт\n";
+    }
+    return 0;
+}
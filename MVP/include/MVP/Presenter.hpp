@@ -6,6 +6,9 @@
 #include <Memory/VariableDescriptor.hpp>
 #include <Memory/ArrayDescriptor.hpp>
 #include <Memory/SharedSegmentDescriptor.hpp>
+#include <Memory/ReferenceDescriptor.hpp>
+#include <map>
+#include <utility>
 
 namespace MVPNameSpace {
 
@@ -17,13 +20,19 @@ enum class DataType {
     Int,
     LongLong,
     SizeT,
-    Double
+    Double,
+    Unknown
 };
 
 class Presenter final {
 private:
+    using ElementTypeKey = std::pair<std::string, std::string>;  // (owning program, element name)
+
     IManager& manager_;
-    std::unordered_map<std::string, DataType> elements_types;
+    std::map<ElementTypeKey, DataType> elements_types;
+
+    // Resolves references to their targets and segments to their owners.
+    const DataType* find_type(const std::string& prog, const std::string& name) const;
 
 public:
     Presenter(IManager& manager) : manager_(manager) {}
@@ -31,9 +40,9 @@ public:
     std::vector<std::string> get_elements_by_program(const std::string& prog);
     std::vector<std::string> get_segments();
     std::vector<std::string> get_segments(const std::string& prog);
-    DataType get_type(const std::string& name);
-    std::string get_value(const std::string& name, size_t begin = 0, size_t end = 0);
-    bool is_array(const std::string& name);
+    DataType get_type(const std::string& prog, const std::string& name) const;
+    std::string get_value(const std::string& prog, const std::string& name, size_t begin = 0, size_t end = 0);
+    bool is_array(const std::string& prog, const std::string& name) const;
     bool add_program(const std::string& name, const std::string& file_path, size_t memory_limit);
     void delete_program(const std::string& name);
     bool make_reference(const std::string& name, const std::string& target_name, const std::string& prog);
@@ -47,32 +56,34 @@ public:
 
     template<typename T>
     bool allocate_variable(const std::string& prog, const std::string& name, DataType type_name){
-        auto it = manager_.get_programs().find(prog);
-        auto elem = it->second->allocate_element<VariableDescriptor>(name, sizeof(T));
-        if(elem != nullptr) elements_types.insert({elem->get_name(), type_name});
+        Program* program = manager_.find_program(prog);
+        auto elem = program->allocate_element<VariableDescriptor>(name, sizeof(T));
+        if(elem != nullptr) elements_types.insert_or_assign(ElementTypeKey{prog, elem->get_name()}, type_name);
         return (elem != nullptr);
     }
 
     template<typename T>
     bool allocate_array(const std::string& prog, const std::string& name, const size_t& count_elements, DataType type_name){
-        auto it = manager_.get_programs().find(prog);
-        auto elem = it->second->allocate_element<ArrayDescriptor>(name, sizeof(T) * count_elements, sizeof(T));
-        if(elem != nullptr) elements_types.insert({elem->get_name(), type_name});
+        Program* program = manager_.find_program(prog);
+        auto elem = program->allocate_element<ArrayDescriptor>(name, sizeof(T) * count_elements, sizeof(T));
+        if(elem != nullptr) elements_types.insert_or_assign(ElementTypeKey{prog, elem->get_name()}, type_name);
         return (elem != nullptr);
     }
 
     template<typename T>
     bool allocate_shared(const std::string& prog, const std::string& name, const size_t& count_elements, DataType type_name){
-        auto it = manager_.get_programs().find(prog);
-        auto elem = it->second->allocate_element<SharedSegmentDescriptor>(name, sizeof(T) * count_elements, sizeof(T), it->second);
-        if(elem != nullptr) elements_types.insert({elem->get_name(), type_name});
+        Program* program = manager_.find_program(prog);
+        auto elem = program->allocate_element<SharedSegmentDescriptor>(name, sizeof(T) * count_elements, sizeof(T), program);
+        if(elem != nullptr) elements_types.insert_or_assign(ElementTypeKey{prog, elem->get_name()}, type_name);
         return (elem != nullptr);
     }
 
     template<typename T>
-    bool set_value(const std::string& name, T value, size_t begin = 0, size_t end = 0){
+    bool set_value(const std::string& prog, const std::string& name, T value, size_t begin = 0, size_t end = 0){
+        IMemoryElement* element = manager_.find_element(prog, name);
+        if(element == nullptr) return false;
         try{
-            manager_.get_memory_elements().find(name)->second->set_value(value, begin, end);
+            element->set_value(value, begin, end);
         }
         catch(const std::runtime_error& e){
             manager_.record_error(SIZE_ERROR, e.what(), "");
@@ -4,80 +4,90 @@ namespace MVPNameSpace {
 
     std::vector<std::string> Presenter::get_programs_names(){
         std::vector<std::string> names;
-        auto programs = manager_.get_programs();
-        for(auto&& [name, ptr] : programs)
-            names.push_back(name);
+        names.reserve(manager_.program_count());
+        manager_.for_each_program([&names](Program& program){ names.push_back(program.get_name()); });
         return names;
     }
 
     std::vector<std::string> Presenter::get_elements_by_program(const std::string& prog){
-        auto it = manager_.get_programs().find(prog);
+        Program* program = manager_.find_program(prog);
         std::vector<std::string> names;
-        auto elements = it->second->get_memory_elements();
+        const auto& elements = program->get_memory_elements();
         for(auto&& [name, ptr] : elements){
-            names.push_back(name);
+            names.emplace_back(name);
         }
         return names;
     }
 
     std::vector<std::string> Presenter::get_segments(){
-        auto elements = manager_.get_memory_elements();
         std::vector<std::string> segments;
-        for(auto&& [name, ptr] : elements){
-            SharedSegmentDescriptor* segment = dynamic_cast<SharedSegmentDescriptor*>(ptr);
-            if(segment)
-                segments.push_back(segment->get_name());
-        }
+        manager_.for_each_element([&segments](IMemoryElement& element){
+            if(element.get_kind() == ElementKind::Shared)
+                segments.push_back(element.get_name());
+        });
         return segments;
     }
 
     std::vector<std::string> Presenter::get_segments(const std::string& prog){
-        auto it = manager_.get_programs().find(prog);
-        auto elements = it->second->get_memory_elements();
+        Program* program = manager_.find_program(prog);
+        const auto& elements = program->get_memory_elements();
         std::vector<std::string> segments;
         for(auto&& [name, ptr] : elements){
-            SharedSegmentDescriptor* segment = dynamic_cast<SharedSegmentDescriptor*>(ptr);
+            SharedSegmentDescriptor* segment = element_cast<SharedSegmentDescriptor>(ptr);
             if(segment)
                 segments.push_back(segment->get_name());
         }
         return segments;
     }
 
-    DataType Presenter::get_type(const std::string& name){
-        return elements_types.find(name)->second;
+    const DataType* Presenter::find_type(const std::string& prog, const std::string& name) const {
+        const IMemoryElement* element = manager_.find_element(prog, name);
+        if(const ReferenceDescriptor* reference = element_cast<ReferenceDescriptor>(element))
+            element = reference->get_target();
+        if(element == nullptr || element->get_id() == INVALID_ELEMENT_ID) return nullptr;
+        Program* owner = manager_.find_program(manager_.get_element_table().get_owner(element->get_id()));
+        if(owner == nullptr) return nullptr;
+        auto it = elements_types.find(ElementTypeKey{owner->get_name(), element->get_name()});
+        return it != elements_types.end() ? &it->second : nullptr;
     }
 
-    std::string Presenter::get_value(const std::string& name, size_t begin, size_t end){
-        DataType type = elements_types.find(name)->second;
-        switch (type){
+    DataType Presenter::get_type(const std::string& prog, const std::string& name) const {
+        const DataType* type = find_type(prog, name);
+        return type != nullptr ? *type : DataType::Unknown;
+    }
+
+    std::string Presenter::get_value(const std::string& prog, const std::string& name, size_t begin, size_t end){
+        IMemoryElement* element = manager_.find_element(prog, name);
+        if(element == nullptr) return std::string("BAD TYPE!");
+        switch (get_type(prog, name)){
         case DataType::Bool:{
             bool val = false;
-            manager_.get_memory_elements().find(name)->second->get_value(val, begin, end);
+            element->get_value(val, begin, end);
             return std::to_string(val);
             break;}
         case DataType::Char:{
             char val = ' ';
-            manager_.get_memory_elements().find(name)->second->get_value(val, begin, end);
+            element->get_value(val, begin, end);
             return std::to_string(val);
             break;}
         case DataType::Int:{
             int val = 0;
-            manager_.get_memory_elements().find(name)->second->get_value(val, begin, end);
+            element->get_value(val, begin, end);
             return std::to_string(val);
             break;}
         case DataType::LongLong:{
             long long val = 0;
-            manager_.get_memory_elements().find(name)->second->get_value(val, begin, end);
+            element->get_value(val, begin, end);
             return std::to_string(val);
             break;}
         case DataType::SizeT:{
             size_t val = 0;
-            manager_.get_memory_elements().find(name)->second->get_value(val, begin, end);
+            element->get_value(val, begin, end);
             return std::to_string(val);
             break;}
         case DataType::Double:{
             double val = 0;
-            manager_.get_memory_elements().find(name)->second->get_value(val, begin, end);
+            element->get_value(val, begin, end);
             return std::to_string(val);
             break;}
         default:
@@ -86,9 +96,8 @@ namespace MVPNameSpace {
         return std::string("BAD TYPE!");
     }
 
-    bool Presenter::is_array(const std::string& name){
-        auto it = manager_.get_element(name);
-        auto array = dynamic_cast<ArrayDescriptor*>(it);
+    bool Presenter::is_array(const std::string& prog, const std::string& name) const {
+        auto array = element_cast<ArrayDescriptor>(manager_.find_element(prog, name));
         if(array) return true;
         return false;
     }
@@ -100,19 +109,21 @@ namespace MVPNameSpace {
 
     void Presenter::delete_program(const std::string& name){
         manager_.delete_program(name);
+        auto first = elements_types.lower_bound(ElementTypeKey{name, std::string()});
+        auto last = first;
+        while(last != elements_types.end() && last->first.first == name) ++last;
+        elements_types.erase(first, last);
     }
 
     bool Presenter::make_reference(const std::string& name, const std::string& target_name, const std::string& prog){
-        auto it = manager_.get_programs().find(prog);
-        ReferenceDescriptor* reference = it->second->make_reference(name, target_name);
-        if(reference != nullptr) elements_types.insert({name, elements_types.find(name)->second});
+        // References take the type of their target, see find_type.
+        ReferenceDescriptor* reference = manager_.find_program(prog)->make_reference(name, target_name);
         return (reference != nullptr);
     }
 
     bool Presenter::delete_element(const std::string& name, const std::string& prog){
-        auto it = manager_.get_programs().find(prog);
-        bool flag = it->second->destroy_element(name);
-        if(flag) elements_types.erase(name);
+        bool flag = manager_.find_program(prog)->destroy_element(name);
+        if(flag) elements_types.erase(ElementTypeKey{prog, name});
         return flag;
     }
 
@@ -129,13 +140,13 @@ namespace MVPNameSpace {
     }
 
     void Presenter::statistics(std::vector<float>& values, std::vector<std::string>& names){
-        auto stat = manager_.statistics();
-        values.reserve(stat.size());
-        names.reserve(stat.size());
-        for(auto&& [name, value] : stat){
-            values.push_back(value);
-            names.push_back(name);
-        }
+        MemoryStats stats = manager_.get_stats();
+        values.reserve(manager_.program_count());
+        names.reserve(manager_.program_count());
+        manager_.for_each_program([&](Program& program){
+            values.push_back(static_cast<float>(stats.usage(program.get_id())) / static_cast<float>(stats.capacity));
+            names.push_back(program.get_name());
+        });
     }
 
     std::vector<std::string> Presenter::errors(){
@@ -657,7 +657,7 @@ void View::render_ui(){
                 std::vector<std::string> elements = elements_combo(selected_element, programs, selected_program);
 
                 if(!elements.empty()){
-                    switch (presenter_.get_type(elements[selected_element])){
+                    switch (presenter_.get_type(programs[selected_program], elements[selected_element])){
                     case DataType::Bool:
                         ImGui::Checkbox("bool", &bool_val);
                         break;
@@ -683,7 +683,7 @@ void View::render_ui(){
                 }
                 
                 static size_t arr_index = 0;
-                if(presenter_.is_array(elements[selected_element]))
+                if(!elements.empty() && presenter_.is_array(programs[selected_program], elements[selected_element]))
                     ImGui::InputScalar("Index", ImGuiDataType_U64, &arr_index);
 
                 ImGui::Separator();
@@ -694,24 +694,26 @@ void View::render_ui(){
                     }
                     else{
                         bool great_add = false;
-                        switch (presenter_.get_type(elements[selected_element])){
+                        switch (presenter_.get_type(programs[selected_program], elements[selected_element])){
                             case DataType::Bool:
-                                great_add = presenter_.set_value(elements[selected_element], bool_val, arr_index);
+                                great_add = presenter_.set_value(programs[selected_program], elements[selected_element], bool_val, arr_index);
                                 break;
                             case DataType::Char:
-                                great_add = presenter_.set_value(elements[selected_element], char_val, arr_index);
+                                great_add = presenter_.set_value(programs[selected_program], elements[selected_element], char_val, arr_index);
                                 break;
                             case DataType::Int:
-                                great_add = presenter_.set_value(elements[selected_element], int_val, arr_index);
+                                great_add = presenter_.set_value(programs[selected_program], elements[selected_element], int_val, arr_index);
                                 break;
                             case DataType::LongLong:
-                                great_add = presenter_.set_value(elements[selected_element], long_val, arr_index);
+                                great_add = presenter_.set_value(programs[selected_program], elements[selected_element], long_val, arr_index);
                                 break;
                             case DataType::SizeT:
-                                great_add = presenter_.set_value(elements[selected_element], size_val, arr_index);
+                                great_add = presenter_.set_value(programs[selected_program], elements[selected_element], size_val, arr_index);
                                 break;
                             case DataType::Double:
-                                great_add = presenter_.set_value(elements[selected_element], double_val, arr_index);
+                                great_add = presenter_.set_value(programs[selected_program], elements[selected_element], double_val, arr_index);
+                                break;
+                            case DataType::Unknown:
                                 break;
                         }
                         std::string message = great_add ? ("Value for " + std::string(elements[selected_element]) + " was set")
@@ -745,7 +747,7 @@ void View::render_ui(){
                 std::vector<std::string> elements = elements_combo(selected_element, programs, selected_program);
 
                 static size_t arr_index = 0;
-                if(presenter_.is_array(elements[selected_element]))
+                if(!elements.empty() && presenter_.is_array(programs[selected_program], elements[selected_element]))
                     ImGui::InputScalar("Index", ImGuiDataType_U64, &arr_index);
 
                 ImGui::Separator();
@@ -755,7 +757,7 @@ void View::render_ui(){
                         ImGui::CloseCurrentPopup();
                     }
                     else{
-                        std::string value = presenter_.get_value(elements[selected_element], arr_index);
+                        std::string value = presenter_.get_value(programs[selected_program], elements[selected_element], arr_index);
                         std::string message = ("Value in '" + elements[selected_element] + "' is: " + value);
                         output_buffer.push_back(message);
                         selected_program = 0;
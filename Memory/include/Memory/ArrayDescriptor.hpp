@@ -2,7 +2,15 @@
 #define ARRAYDESCRIPTOR_HPP
 
 #include <string>
+#include <span>
+#include <optional>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
 #include <Memory/MemoryElement.hpp>
+#include <Memory/PinnedSpan.hpp>
+#include <Memory/BulkCopy.hpp>
+#include <Memory/ArrayKernels.hpp>
 
 namespace MemoryNameSpace{
 
@@ -15,7 +23,46 @@ namespace MemoryNameSpace{
  */
 class ArrayDescriptor : public MemoryElement{
 protected:
-    size_t element_size_;  ///< Size of individual array elements in bytes
+    /**
+     * @brief Validates a typed range access
+     * 
+     * @param begin Index of the first element
+     * @param end Index past the last element
+     * @param type_size Size of the accessed type in bytes
+     * @return true if the range lies within the array
+     * @return false if the range is invalid or out of bounds (error recorded)
+     * @throws std::runtime_error If the type size doesn't match the element size
+     */
+    bool check_range(size_t begin, size_t end, size_t type_size) const;
+
+    /**
+     * @brief Gets the address of an array element in the buffer
+     * 
+     * @param index Index of the element
+     * @return std::byte* Pointer to the element's first byte
+     * @throws std::runtime_error If the buffer has no storage
+     */
+    std::byte* element_data(size_t index) const;
+
+    /**
+     * @brief Records an error about arrays of different lengths
+     * 
+     * @param other Array the operation was applied with
+     */
+    void record_length_mismatch(const ArrayDescriptor& other) const;
+
+    /**
+     * @brief Constructs an array-like descriptor of a derived kind
+     * 
+     * @param kind Concrete kind of the element
+     * @param name Name of the array
+     * @param size Total size in bytes
+     * @param offset Offset in the memory buffer
+     * @param element_size Size of individual elements in bytes
+     * @param manager Reference to the memory manager
+     */
+    ArrayDescriptor(ElementKind kind, const std::string& name, size_t size, size_t offset, size_t element_size, IManager& manager)
+            : MemoryElement(kind, name, size, offset, element_size, manager) {}
 
 public:
     /**
@@ -28,7 +75,15 @@ public:
      * @param manager Reference to the memory manager
      */
     ArrayDescriptor(const std::string& name, size_t size, size_t offset, size_t element_size, IManager& manager)
-            : MemoryElement(name, size, offset, manager), element_size_(element_size) {}
+            : MemoryElement(ElementKind::Array, name, size, offset, element_size, manager) {}
+
+    /**
+     * @brief Checks whether a kind denotes an ArrayDescriptor
+     * 
+     * @param kind Kind to check
+     * @return true for arrays and shared segments
+     */
+    static constexpr bool has_kind(ElementKind kind) noexcept { return kind == ElementKind::Array || kind == ElementKind::Shared; }
     
     /**
      * @brief Gets the size of individual array elements
@@ -54,6 +109,233 @@ public:
      * @param end Ending byte offset within array (0 for all)
      */
     void set_raw_value(const std::byte* value, size_t begin, size_t end) override;
+
+    /**
+     * @brief Copies a range of elements out of the array
+     * 
+     * Bounds are checked once per call; large ranges are copied with
+     * non-temporal stores.
+     * 
+     * @tparam T Element type (must be trivially copyable and match the element size)
+     * @param begin Index of the first element to read
+     * @param out Destination for out.size() elements
+     * @return true if the range was copied
+     * @return false if the range is out of bounds (error recorded)
+     * @throws std::runtime_error If the type size doesn't match the element size
+     */
+    template<typename T>
+    bool read_range(size_t begin, std::span<T> out) const {
+        static_assert(std::is_trivially_copyable_v<T>, "ArrayDescriptor::read_range<T> requires trivially copyable type T.");
+        if(!check_range(begin, begin + out.size(), sizeof(T))) return false;
+        copy_bytes(reinterpret_cast<std::byte*>(out.data()), element_data(begin), out.size_bytes());
+        return true;
+    }
+
+    /**
+     * @brief Copies a range of elements into the array
+     * 
+     * @tparam T Element type (must be trivially copyable and match the element size)
+     * @param begin Index of the first element to write
+     * @param values Elements to write
+     * @return true if the range was written
+     * @return false if the range is out of bounds (error recorded)
+     * @throws std::runtime_error If the type size doesn't match the element size
+     */
+    template<typename T>
+    bool write_range(size_t begin, std::span<const T> values){
+        static_assert(std::is_trivially_copyable_v<T>, "ArrayDescriptor::write_range<T> requires trivially copyable type T.");
+        if(!check_range(begin, begin + values.size(), sizeof(T))) return false;
+        copy_bytes(element_data(begin), reinterpret_cast<const std::byte*>(values.data()), values.size_bytes());
+        return true;
+    }
+
+    /**
+     * @brief Assigns a value to a range of elements
+     * 
+     * @tparam T Element type (must be trivially copyable and match the element size)
+     * @param begin Index of the first element to assign
+     * @param end Index past the last element to assign
+     * @param value Value to store
+     * @return true if the range was filled
+     * @return false if the range is invalid or out of bounds (error recorded)
+     * @throws std::runtime_error If the type size doesn't match the element size
+     */
+    template<typename T>
+    bool fill(size_t begin, size_t end, const T& value){
+        static_assert(std::is_trivially_copyable_v<T>, "ArrayDescriptor::fill<T> requires trivially copyable type T.");
+        if(!check_range(begin, end, sizeof(T))) return false;
+        fill_bytes(element_data(begin), end - begin, reinterpret_cast<const std::byte*>(&value), sizeof(T));
+        return true;
+    }
+
+    /**
+     * @brief Sums the array elements in place
+     * 
+     * Runs a vectorized kernel on the managed buffer; large arrays are
+     * split across the TBB thread pool.
+     * 
+     * @tparam T Element type (int, long long, size_t or double matching the element size)
+     * @return sum_t<T> Sum of all elements (int sums are widened to long long)
+     * @throws std::runtime_error If the type size doesn't match the element size
+     */
+    template<reducible_t T>
+    sum_t<T> sum() const {
+        size_t count = typed_length<T>();
+        return reduce_sum<T>(element_data(0), count);
+    }
+
+    /**
+     * @brief Finds the smallest and largest array elements
+     * 
+     * @tparam T Element type (int, long long, size_t or double matching the element size)
+     * @return std::optional<std::pair<T, T>> Minimum and maximum, or nullopt for an empty array
+     * @throws std::runtime_error If the type size doesn't match the element size
+     */
+    template<reducible_t T>
+    std::optional<std::pair<T, T>> minmax() const {
+        size_t count = typed_length<T>();
+        if(count == 0) return std::nullopt;
+        return reduce_minmax<T>(element_data(0), count);
+    }
+
+    /**
+     * @brief Finds the smallest array element
+     * 
+     * @tparam T Element type (int, long long, size_t or double matching the element size)
+     * @return std::optional<T> Minimum, or nullopt for an empty array
+     * @throws std::runtime_error If the type size doesn't match the element size
+     */
+    template<reducible_t T>
+    std::optional<T> min() const {
+        if(auto result = minmax<T>(); result.has_value()) return result->first;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Finds the largest array element
+     * 
+     * @tparam T Element type (int, long long, size_t or double matching the element size)
+     * @return std::optional<T> Maximum, or nullopt for an empty array
+     * @throws std::runtime_error If the type size doesn't match the element size
+     */
+    template<reducible_t T>
+    std::optional<T> max() const {
+        if(auto result = minmax<T>(); result.has_value()) return result->second;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Counts array elements satisfying a comparison with a value
+     * 
+     * @tparam T Element type (int, long long, size_t or double matching the element size)
+     * @param compare Comparison to apply
+     * @param value Right-hand side of the comparison
+     * @return size_t Number of matching elements
+     * @throws std::runtime_error If the type size doesn't match the element size
+     */
+    template<reducible_t T>
+    size_t count_if(Compare compare, T value) const {
+        size_t count = typed_length<T>();
+        return reduce_count<T>(element_data(0), count, compare, value);
+    }
+
+    /**
+     * @brief Computes the dot product with another array
+     * 
+     * @tparam T Element type (int, long long, size_t or double matching the element size)
+     * @param other Array with the same number of elements
+     * @return std::optional<sum_t<T>> Dot product, or nullopt if lengths differ (error recorded)
+     * @throws std::runtime_error If the type size doesn't match the element size of either array
+     */
+    template<reducible_t T>
+    std::optional<sum_t<T>> dot(const ArrayDescriptor& other) const {
+        size_t count = typed_length<T>();
+        if(other.typed_length<T>() != count){
+            record_length_mismatch(other);
+            return std::nullopt;
+        }
+        return reduce_dot<T>(element_data(0), other.element_data(0), count);
+    }
+
+    /**
+     * @brief Replaces each element by the sum of itself and all preceding elements
+     * 
+     * @tparam T Element type (int, long long, size_t or double matching the element size)
+     * @throws std::runtime_error If the type size doesn't match the element size
+     */
+    template<reducible_t T>
+    void prefix_sum(){
+        size_t count = typed_length<T>();
+        inclusive_prefix_sum<T>(element_data(0), count);
+    }
+
+    /**
+     * @brief Gets a pinned typed view over the array contents
+     * 
+     * The data is not copied. While the view is alive the array can't be
+     * moved by defragmentation or destroyed.
+     * 
+     * @tparam T Element type (must be trivially copyable and match the element size)
+     * @return PinnedSpan<T> View over all array elements
+     * @throws std::runtime_error If the type size doesn't match the element size
+     *         or the data isn't suitably aligned for T
+     */
+    template<typename T>
+    PinnedSpan<T> view(){
+        return PinnedSpan<T>(table_, id_, typed_span<T>(manager_.get_data()));
+    }
+
+    /**
+     * @brief Gets a pinned read-only typed view over the array contents
+     * 
+     * @tparam T Element type (must be trivially copyable and match the element size)
+     * @return PinnedSpan<const T> Read-only view over all array elements
+     * @throws std::runtime_error If the type size doesn't match the element size
+     *         or the data isn't suitably aligned for T
+     */
+    template<typename T>
+    PinnedSpan<const T> view() const {
+        return PinnedSpan<const T>(table_, id_, typed_span<const T>(std::as_const(manager_).get_data()));
+    }
+
+protected:
+    /**
+     * @brief Counts the array elements as values of T
+     * 
+     * Unlike typed_span, any alignment is accepted; the kernels read
+     * through memcpy.
+     * 
+     * @tparam T Element type
+     * @return size_t Number of elements
+     * @throws std::runtime_error If the type size doesn't match the element size
+     */
+    template<typename T>
+    size_t typed_length() const {
+        if(table_.get_elem_size(id_) != sizeof(T))
+            throw std::runtime_error("Size mismatch in ArrayDescriptor reduction.");
+        return table_.get_size(id_) / sizeof(T);
+    }
+
+    /**
+     * @brief Builds an unpinned span over the array contents
+     * 
+     * @tparam T Element type, possibly const-qualified
+     * @tparam Byte std::byte or const std::byte
+     * @param data Start of the manager's buffer
+     * @return std::span<T> Span over all array elements
+     */
+    template<typename T, typename Byte>
+    std::span<T> typed_span(Byte* data) const {
+        static_assert(std::is_trivially_copyable_v<T>, "ArrayDescriptor::view<T> requires trivially copyable type T.");
+        if(table_.get_elem_size(id_) != sizeof(T))
+            throw std::runtime_error("Size mismatch in ArrayDescriptor::view<T>.");
+        if(data == nullptr)
+            throw std::runtime_error("No storage behind ArrayDescriptor::view<T>.");
+        Byte* begin = data + table_.get_offset(id_);
+        if(reinterpret_cast<uintptr_t>(begin) % alignof(T) != 0)
+            throw std::runtime_error("Misaligned data in ArrayDescriptor::view<T>.");
+        return std::span<T>(reinterpret_cast<T*>(begin), table_.get_size(id_) / sizeof(T));
+    }
 };
 
 }
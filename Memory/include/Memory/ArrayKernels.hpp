@@ -0,0 +1,149 @@
+#ifndef ARRAYKERNELS_HPP
+#define ARRAYKERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <concepts>
+#include <span>
+#include <utility>
+#include <type_traits>
+
+namespace MemoryNameSpace{
+
+/**
+ * @concept reducible_t
+ * @brief Element types supported by the array kernels
+ */
+template<typename T>
+concept reducible_t =
+    std::same_as<T, int> ||
+    std::same_as<T, long long> ||
+    std::same_as<T, size_t> ||
+    std::same_as<T, double>;
+
+/**
+ * @brief Accumulator type of sums and dot products
+ *
+ * Sums of int are widened to long long; other types accumulate in place.
+ *
+ * @tparam T Element type
+ */
+template<reducible_t T>
+using sum_t = std::conditional_t<std::is_same_v<T, int>, long long, T>;
+
+/**
+ * @enum Compare
+ * @brief Comparison applied by reduce_count
+ */
+enum class Compare : uint8_t {
+    Equal,        ///< element == value
+    NotEqual,     ///< element != value
+    Less,         ///< element < value
+    LessEqual,    ///< element <= value
+    Greater,      ///< element > value
+    GreaterEqual  ///< element >= value
+};
+
+/**
+ * @brief Number of elements from which kernels run on the TBB thread pool
+ */
+inline constexpr size_t PARALLEL_THRESHOLD = 1 << 16;
+
+// The kernels read and write through memcpy, so data may start at any
+// byte offset of the managed buffer.
+
+/**
+ * @brief Sums all elements
+ *
+ * @param data First byte of the elements
+ * @param count Number of elements
+ * @return sum_t<T> Sum of the elements
+ */
+template<reducible_t T>
+sum_t<T> reduce_sum(const std::byte* data, size_t count);
+
+/**
+ * @brief Finds the smallest and largest elements
+ *
+ * @param data First byte of the elements
+ * @param count Number of elements (must not be 0)
+ * @return std::pair<T, T> Minimum and maximum
+ */
+template<reducible_t T>
+std::pair<T, T> reduce_minmax(const std::byte* data, size_t count);
+
+/**
+ * @brief Counts elements satisfying a comparison with a value
+ *
+ * @param data First byte of the elements
+ * @param count Number of elements
+ * @param compare Comparison to apply
+ * @param value Right-hand side of the comparison
+ * @return size_t Number of matching elements
+ */
+template<reducible_t T>
+size_t reduce_count(const std::byte* data, size_t count, Compare compare, T value);
+
+/**
+ * @brief Computes the dot product of two ranges of equal length
+ *
+ * @param lhs First byte of the first range
+ * @param rhs First byte of the second range
+ * @param count Number of elements in each range
+ * @return sum_t<T> Dot product
+ */
+template<reducible_t T>
+sum_t<T> reduce_dot(const std::byte* lhs, const std::byte* rhs, size_t count);
+
+/**
+ * @brief Replaces each element by the sum of itself and all preceding elements
+ *
+ * @param data First byte of the elements, scanned in place
+ * @param count Number of elements
+ */
+template<reducible_t T>
+void inclusive_prefix_sum(std::byte* data, size_t count);
+
+/**
+ * @brief Sums all elements of a span
+ */
+template<reducible_t T>
+sum_t<T> reduce_sum(std::span<const T> data){
+    return reduce_sum<T>(reinterpret_cast<const std::byte*>(data.data()), data.size());
+}
+
+/**
+ * @brief Finds the smallest and largest elements of a non-empty span
+ */
+template<reducible_t T>
+std::pair<T, T> reduce_minmax(std::span<const T> data){
+    return reduce_minmax<T>(reinterpret_cast<const std::byte*>(data.data()), data.size());
+}
+
+/**
+ * @brief Counts elements of a span satisfying a comparison with a value
+ */
+template<reducible_t T>
+size_t reduce_count(std::span<const T> data, Compare compare, T value){
+    return reduce_count<T>(reinterpret_cast<const std::byte*>(data.data()), data.size(), compare, value);
+}
+
+/**
+ * @brief Computes the dot product of two spans of equal length
+ */
+template<reducible_t T>
+sum_t<T> reduce_dot(std::span<const T> lhs, std::span<const T> rhs){
+    return reduce_dot<T>(reinterpret_cast<const std::byte*>(lhs.data()), reinterpret_cast<const std::byte*>(rhs.data()), lhs.size());
+}
+
+/**
+ * @brief Computes the inclusive prefix sum of a span in place
+ */
+template<reducible_t T>
+void inclusive_prefix_sum(std::span<T> data){
+    inclusive_prefix_sum<T>(reinterpret_cast<std::byte*>(data.data()), data.size());
+}
+
+}
+
+#endif
@@ -2,7 +2,12 @@
 #define BUFFER_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <array>
+#include <expected>
+#include <iterator>
+#include <new>
+#include <set>
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
@@ -19,6 +24,62 @@ struct Block{
     size_t size = 0;    ///< Size of the block in bytes
 };
 
+/**
+ * @enum BufferError
+ * @brief Reasons a block operation on a buffer can fail
+ */
+enum class BufferError : uint8_t {
+    Overflow,    ///< No free block is large enough
+    OutOfRange,  ///< Offset/size lie outside the buffer
+    DoubleFree   ///< The block overlaps free memory
+};
+
+/**
+ * @brief Formats the message of a failed block operation
+ * 
+ * Only called when the failure is reported, so the failing
+ * operation itself doesn't allocate.
+ * 
+ * @param error Failure reason
+ * @param offset Offset passed to the operation
+ * @param size Size passed to the operation
+ * @return std::string Error message
+ */
+inline std::string describe_buffer_error(BufferError error, size_t offset, size_t size){
+    switch(error){
+    case BufferError::Overflow: return "Buffer overflow.";
+    case BufferError::OutOfRange: return "Invalid offset " + std::to_string(offset) + " with size " + std::to_string(size) + ".";
+    case BufferError::DoubleFree: return "Double free.";
+    }
+    return "";
+}
+
+/**
+ * @brief Gets the alignment of blocks holding elements of a given size
+ * 
+ * The largest power of two dividing the element size, capped at the
+ * alignment of std::max_align_t, so arrays of any fundamental type are
+ * aligned for it.
+ * 
+ * @param element_size Size of one element in bytes
+ * @return size_t Alignment in bytes (1 for a size of 0)
+ */
+constexpr size_t natural_alignment(size_t element_size) noexcept {
+    if(element_size == 0) return 1;
+    return std::min(element_size & (~element_size + 1), alignof(std::max_align_t));
+}
+
+/**
+ * @brief Gets the bytes to skip from an offset to the next multiple of an alignment
+ * 
+ * @param offset Offset of a block
+ * @param alignment Required alignment (not 0)
+ * @return size_t Padding in bytes
+ */
+constexpr size_t alignment_padding(size_t offset, size_t alignment) noexcept {
+    return (alignment - offset % alignment) % alignment;
+}
+
 /**
  * @class IBuffer
  * @brief Interface for memory buffer implementations
@@ -49,14 +110,39 @@ public:
      */
     virtual size_t get_capacity() const noexcept = 0;
     
+    /**
+     * @brief Allocates a block of memory without throwing
+     * 
+     * Bytes skipped in front of the block to reach the alignment stay free.
+     * 
+     * @param size Size to allocate in bytes
+     * @param alignment Required alignment of the offset (not 0)
+     * @return std::expected<size_t, BufferError> Offset of allocated block, or BufferError::Overflow
+     */
+    virtual std::expected<size_t, BufferError> try_allocate_block(size_t size, size_t alignment = 1) noexcept = 0;
+    
+    /**
+     * @brief Destroys a block of memory without throwing on invalid input
+     * 
+     * @param offset Offset of block to destroy
+     * @param size Size of block to destroy
+     * @return std::expected<void, BufferError> Nothing, or BufferError::OutOfRange / BufferError::DoubleFree
+     */
+    virtual std::expected<void, BufferError> try_destroy_block(size_t offset, size_t size) = 0;
+    
     /**
      * @brief Allocates a block of memory
      * 
      * @param size Size to allocate in bytes
+     * @param alignment Required alignment of the offset (not 0)
      * @return size_t Offset of allocated block
      * @throws std::runtime_error If buffer overflow occurs
      */
-    virtual size_t allocate_block(size_t size) = 0;
+    size_t allocate_block(size_t size, size_t alignment = 1){
+        auto offset = try_allocate_block(size, alignment);
+        if(!offset) throw std::runtime_error(describe_buffer_error(offset.error(), 0, size));
+        return *offset;
+    }
     
     /**
      * @brief Destroys a block of memory
@@ -66,14 +152,48 @@ public:
      * @throws std::out_of_range If offset/size are invalid
      * @throws std::runtime_error If double free occurs
      */
-    virtual void destroy_block(size_t offset, size_t size) = 0;
+    void destroy_block(size_t offset, size_t size){
+        auto result = try_destroy_block(offset, size);
+        if(result) return;
+        if(result.error() == BufferError::OutOfRange)
+            throw std::out_of_range(describe_buffer_error(result.error(), offset, size));
+        throw std::runtime_error(describe_buffer_error(result.error(), offset, size));
+    }
     
     /**
      * @brief Gets the list of free blocks
      * 
-     * @return std::vector<Block>& Reference to vector of free blocks
+     * @return const std::vector<Block>& Free blocks ordered by offset
+     */
+    virtual const std::vector<Block>& get_blocks() const = 0;
+
+    /**
+     * @brief Gets the number of free blocks
+     * 
+     * @return size_t Number of free blocks
+     */
+    virtual size_t get_free_block_count() const noexcept = 0;
+    
+    /**
+     * @brief Replaces the free list after allocated blocks were packed to the front
+     * 
+     * @param used Bytes occupied by the packed blocks; [used, capacity) becomes one free block
+     */
+    virtual void compact(size_t used) = 0;
+    
+    /**
+     * @brief Gets the number of free bytes
+     * 
+     * @return size_t Sum of the sizes of all free blocks
      */
-    virtual std::vector<Block>& get_blocks() = 0;
+    virtual size_t get_free_memory() const noexcept = 0;
+    
+    /**
+     * @brief Gets the size of the largest free block
+     * 
+     * @return size_t Size in bytes, or 0 if the buffer is full
+     */
+    virtual size_t get_largest_free_block() const noexcept = 0;
     
     /**
      * @brief Virtual destructor for interface
@@ -86,15 +206,19 @@ public:
  * @brief Fixed-size memory buffer implementation
  * 
  * Buffer implements IBuffer using a fixed-size array and
- * maintains a list of free blocks for allocation.
+ * maintains a list of free blocks for allocation. The free byte count
+ * and a multiset of free block sizes are kept in step with the list,
+ * so the largest free block is known without a scan.
  * 
  * @tparam capacity_ Fixed capacity of the buffer in bytes
  */
 template<size_t capacity_>
 class Buffer final : public IBuffer{
 private:
-    std::array<std::byte, capacity_> buffer_; ///< Underlying memory storage
+    alignas(std::max_align_t) std::array<std::byte, capacity_> buffer_; ///< Underlying memory storage
     std::vector<Block> blocks_;               ///< List of free memory blocks
+    std::multiset<size_t> free_sizes_;        ///< Sizes of the free blocks
+    size_t free_bytes_ = capacity_;           ///< Total size of the free blocks
 
 public:
     /**
@@ -102,7 +226,7 @@ public:
      * 
      * Initializes with a single free block covering the entire buffer.
      */
-    Buffer() : IBuffer(), blocks_(std::vector<Block>{{0, capacity_}}) {};
+    Buffer() : IBuffer(), blocks_(std::vector<Block>{{0, capacity_}}), free_sizes_{capacity_} {};
     
     /**
      * @brief Destructor for Buffer
@@ -131,70 +255,157 @@ public:
     constexpr size_t get_capacity() const noexcept override { return capacity_; }
     
     /**
-     * @brief Allocates a block of memory
+     * @brief Allocates a block of memory without throwing
      * 
-     * Uses first-fit algorithm to find a suitable free block.
+     * Uses first-fit algorithm to find a suitable free block. Padding in
+     * front of an aligned block is kept as a free block of its own.
      * 
      * @param size Size to allocate in bytes
-     * @return size_t Offset of allocated block
-     * @throws std::runtime_error If no suitable free block found (buffer overflow)
-     */
-    size_t allocate_block(size_t size) override {
-        size_t offset_res = 0;
-        auto it = std::find_if(blocks_.begin(), blocks_.end(),
-                                [size](const Block& block){ return block.size >= size; });
-        if(it == blocks_.end()) throw std::runtime_error("Buffer overflow.");
-        offset_res = it->offset;
-        if(size == it->size) blocks_.erase(it);
+     * @param alignment Required alignment of the offset (not 0)
+     * @return std::expected<size_t, BufferError> Offset of allocated block, or BufferError::Overflow
+     */
+    std::expected<size_t, BufferError> try_allocate_block(size_t size, size_t alignment = 1) noexcept override {
+        auto it = std::find_if(blocks_.begin(), blocks_.end(), [size, alignment](const Block& block){
+            return block.size >= size && block.size - size >= alignment_padding(block.offset, alignment);
+        });
+        if(it == blocks_.end()) return std::unexpected(BufferError::Overflow);
+        size_t padding = alignment_padding(it->offset, alignment);
+        size_t offset_res = it->offset + padding;
+        if(padding != 0){
+            try{
+                it = std::next(blocks_.insert(it, Block{it->offset, padding}));
+            }
+            catch(const std::bad_alloc&){
+                return std::unexpected(BufferError::Overflow);
+            }
+            try{
+                free_sizes_.insert(padding);
+            }
+            catch(const std::bad_alloc&){
+                blocks_.erase(std::prev(it));
+                return std::unexpected(BufferError::Overflow);
+            }
+        }
+        // Shrinking a node's key reuses the node, so only the erase can't allocate.
+        auto node = free_sizes_.extract(free_sizes_.find(it->size));
+        size_t remaining = it->size - padding - size;
+        if(remaining == 0) blocks_.erase(it);
         else{
-            it->offset = it->offset + size;
-            it->size = it->size - size;
+            it->offset = offset_res + size;
+            it->size = remaining;
+            node.value() = remaining;
+            free_sizes_.insert(std::move(node));
         }
+        free_bytes_ -= size;
         return offset_res;
     }
     
     /**
-     * @brief Destroys a block of memory
+     * @brief Destroys a block of memory without throwing on invalid input
      * 
      * Returns memory to the free list and merges adjacent free blocks.
      * 
      * @param offset Offset of block to destroy
      * @param size Size of block to destroy
-     * @throws std::out_of_range If offset/size are outside buffer bounds
-     * @throws std::runtime_error If block is already free (double free)
+     * @return std::expected<void, BufferError> Nothing, or BufferError::OutOfRange if offset/size
+     *         are outside buffer bounds, or BufferError::DoubleFree if the block is already free
+     * @throws std::bad_alloc If a separate free block can't be recorded; the buffer is left unchanged
      */
-    void destroy_block(size_t offset, size_t size) override {
+    std::expected<void, BufferError> try_destroy_block(size_t offset, size_t size) override {
         if((offset > capacity_) || (size > capacity_ - offset))
-            throw std::out_of_range("Invalid offset " + std::to_string(offset) + " with size " + std::to_string(size) + ".");
+            return std::unexpected(BufferError::OutOfRange);
         auto it = std::upper_bound(blocks_.begin(), blocks_.end(), offset,
                                 [](size_t offset, const Block& block){ return offset < block.offset; });
         auto prev = (it != blocks_.begin()) ? std::prev(it) : blocks_.end();
         if(((it != blocks_.end()) && (offset + size > it->offset)) || ((it != blocks_.begin()) && (prev->offset + prev->size > offset)))
-            throw std::runtime_error("Double free.");
-        if((it != blocks_.begin()) && (prev->offset + prev->size == offset)){
+            return std::unexpected(BufferError::DoubleFree);
+        if(size == 0) return {};
+        bool merge_prev = (it != blocks_.begin()) && (prev->offset + prev->size == offset);
+        bool merge_next = (it != blocks_.end()) && (offset + size == it->offset);
+        if(!merge_prev && !merge_next){
+            // The only allocating steps come first, so a throw leaves no trace.
+            auto size_it = free_sizes_.insert(size);
+            try{
+                blocks_.insert(it, Block{offset, size});
+            }
+            catch(...){
+                free_sizes_.erase(size_it);
+                throw;
+            }
+            free_bytes_ += size;
+            return {};
+        }
+        // Merging reuses the node of the grown block, so nothing below allocates.
+        auto grown = merge_prev ? prev : it;
+        auto node = free_sizes_.extract(free_sizes_.find(grown->size));
+        if(merge_prev){
             prev->size += size;
-            if((it != blocks_.end()) && (offset + size == it->offset)){
+            if(merge_next){
                 prev->size += it->size;
+                free_sizes_.erase(free_sizes_.find(it->size));
                 blocks_.erase(it);
             }
-            return;
         }
-        if((it != blocks_.end()) && (offset + size == it->offset)){
+        else{
             it->offset = offset;
             it->size += size;
-            return;
         }
-        blocks_.insert(it, Block{offset, size});
+        node.value() = grown->size;
+        free_sizes_.insert(std::move(node));
+        free_bytes_ += size;
+        return {};
     }
 
     /**
      * @brief Gets the list of free blocks
      * 
-     * @return std::vector<Block>& Reference to vector of free blocks
+     * @return const std::vector<Block>& Free blocks ordered by offset
      */
-    std::vector<Block>& get_blocks() override {
+    const std::vector<Block>& get_blocks() const noexcept override {
         return blocks_;
     }
+
+    /**
+     * @brief Gets the number of free blocks
+     * 
+     * @return size_t Number of free blocks
+     */
+    size_t get_free_block_count() const noexcept override {
+        return blocks_.size();
+    }
+
+    /**
+     * @brief Replaces the free list after allocated blocks were packed to the front
+     * 
+     * @param used Bytes occupied by the packed blocks; [used, capacity) becomes one free block
+     */
+    void compact(size_t used) override {
+        blocks_.clear();
+        free_sizes_.clear();
+        free_bytes_ = used < capacity_ ? capacity_ - used : 0;
+        if(free_bytes_ != 0){
+            blocks_.push_back(Block{used, free_bytes_});
+            free_sizes_.insert(free_bytes_);
+        }
+    }
+
+    /**
+     * @brief Gets the number of free bytes
+     * 
+     * @return size_t Sum of the sizes of all free blocks
+     */
+    size_t get_free_memory() const noexcept override {
+        return free_bytes_;
+    }
+
+    /**
+     * @brief Gets the size of the largest free block
+     * 
+     * @return size_t Size in bytes, or 0 if the buffer is full
+     */
+    size_t get_largest_free_block() const noexcept override {
+        return free_sizes_.empty() ? 0 : *free_sizes_.rbegin();
+    }
 };
 
 }
@@ -0,0 +1,43 @@
+#ifndef BULKCOPY_HPP
+#define BULKCOPY_HPP
+
+#include <cstddef>
+
+namespace MemoryNameSpace{
+
+/**
+ * @brief Size from which bulk operations bypass the cache
+ *
+ * Larger ranges are written with non-temporal stores so a single bulk
+ * copy or fill doesn't evict the working set of other programs.
+ */
+inline constexpr size_t NON_TEMPORAL_THRESHOLD = 1 << 20;
+
+/**
+ * @brief Copies a range of bytes between non-overlapping buffers
+ *
+ * Small ranges use memcpy; ranges of at least NON_TEMPORAL_THRESHOLD
+ * bytes are copied with 16-byte streaming stores.
+ *
+ * @param destination Destination buffer
+ * @param source Source buffer
+ * @param size Number of bytes to copy
+ */
+void copy_bytes(std::byte* destination, const std::byte* source, size_t size) noexcept;
+
+/**
+ * @brief Fills a buffer with copies of a byte pattern
+ *
+ * The pattern is written once and then doubled with memcpy; large
+ * fills with a pattern size dividing 16 use streaming stores.
+ *
+ * @param destination Destination buffer
+ * @param count Number of pattern copies to write
+ * @param pattern Pattern bytes
+ * @param pattern_size Size of the pattern in bytes
+ */
+void fill_bytes(std::byte* destination, size_t count, const std::byte* pattern, size_t pattern_size) noexcept;
+
+}
+
+#endif
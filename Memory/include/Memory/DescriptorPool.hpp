@@ -0,0 +1,180 @@
+#ifndef DESCRIPTORPOOL_HPP
+#define DESCRIPTORPOOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <memory>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+namespace MemoryNameSpace{
+
+/**
+ * @class DescriptorPool
+ * @brief Slab allocator for memory element descriptors
+ *
+ * Objects are carved from 64 KiB slabs aligned to their own size. Every
+ * descriptor type maps to a size class with its own free list, so
+ * creating and destroying elements reuses chunks instead of calling
+ * the global heap. The slab header stores the owning pool and size
+ * class, which lets destroy() release an object from its address alone.
+ *
+ * Slabs are returned to the heap only when the pool is destroyed.
+ * The pool is not thread-safe, like the manager that owns it.
+ */
+class DescriptorPool final{
+public:
+    static constexpr size_t SLAB_SIZE = 64 * 1024;  ///< Size and alignment of a slab
+    static constexpr size_t GRANULARITY = 16;       ///< Chunk size step between size classes
+    static constexpr size_t MAX_CHUNK = 512;        ///< Largest supported object size
+
+private:
+    static constexpr size_t CLASS_COUNT = MAX_CHUNK / GRANULARITY;
+
+    /**
+     * @struct SlabHeader
+     * @brief Header at the start of each slab
+     */
+    struct SlabHeader{
+        DescriptorPool* pool;  ///< Pool owning the slab
+        size_t size_class;     ///< Size class of all chunks in the slab
+        SlabHeader* next;      ///< Next slab of the pool
+    };
+
+    /**
+     * @struct FreeChunk
+     * @brief Free-list link stored inside a released chunk
+     */
+    struct FreeChunk{
+        FreeChunk* next;  ///< Next free chunk of the same size class
+    };
+
+    /**
+     * @struct SizeClass
+     * @brief Allocation state of a single size class
+     */
+    struct SizeClass{
+        FreeChunk* free = nullptr;      ///< Released chunks
+        std::byte* bump = nullptr;      ///< Next never-used chunk in the current slab
+        std::byte* bump_end = nullptr;  ///< End of the current slab
+    };
+
+    std::array<SizeClass, CLASS_COUNT> classes_{};  ///< Per-size free lists
+    SlabHeader* slabs_ = nullptr;                   ///< All slabs owned by the pool
+    size_t slab_count_ = 0;                         ///< Number of allocated slabs
+    size_t live_objects_ = 0;                       ///< Number of allocated chunks
+
+    /**
+     * @brief Allocates a chunk of the given size class
+     *
+     * @param size_class Size class index
+     * @return void* Uninitialized chunk
+     */
+    void* allocate(size_t size_class);
+
+    /**
+     * @brief Returns a chunk to its size class
+     *
+     * @param chunk Chunk to release
+     * @param size_class Size class index
+     */
+    void release(void* chunk, size_t size_class) noexcept;
+
+    /**
+     * @brief Gets the size class for an object type
+     */
+    template<typename T>
+    static constexpr size_t size_class_of() noexcept {
+        static_assert(sizeof(T) <= MAX_CHUNK, "DescriptorPool: descriptor type is too large.");
+        static_assert(alignof(T) <= GRANULARITY, "DescriptorPool: descriptor type is over-aligned.");
+        return (sizeof(T) + GRANULARITY - 1) / GRANULARITY - 1;
+    }
+
+public:
+    /**
+     * @brief Constructs an empty pool without allocating slabs
+     */
+    DescriptorPool() = default;
+
+    DescriptorPool(const DescriptorPool&) = delete;
+    DescriptorPool& operator=(const DescriptorPool&) = delete;
+
+    /**
+     * @brief Frees all slabs
+     *
+     * All objects created by the pool must be destroyed beforehand.
+     */
+    ~DescriptorPool();
+
+    /**
+     * @brief Creates an object in a pooled chunk
+     *
+     * @tparam T Object type
+     * @param args Constructor arguments
+     * @return T* Pointer to the created object
+     */
+    template<typename T, typename... Args>
+    T* create(Args&&... args){
+        constexpr size_t size_class = size_class_of<T>();
+        void* chunk = allocate(size_class);
+        try{ return ::new(chunk) T(std::forward<Args>(args)...); }
+        catch(...){
+            release(chunk, size_class);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Destroys an object created by any pool
+     *
+     * @tparam T Static type of the object (must have a virtual destructor if polymorphic)
+     * @param object Object to destroy
+     */
+    template<typename T>
+    static void destroy(T* object) noexcept {
+        if(object == nullptr) return;
+        void* chunk = nullptr;
+        if constexpr (std::is_polymorphic_v<T>) chunk = dynamic_cast<void*>(object);
+        else chunk = static_cast<void*>(object);
+        object->~T();
+        SlabHeader* slab = reinterpret_cast<SlabHeader*>(reinterpret_cast<uintptr_t>(chunk) & ~(SLAB_SIZE - 1));
+        slab->pool->release(chunk, slab->size_class);
+    }
+
+    /**
+     * @brief Gets the number of live objects
+     *
+     * @return size_t Number of allocated chunks
+     */
+    size_t get_live_objects() const noexcept;
+
+    /**
+     * @brief Gets the heap memory held by the pool
+     *
+     * @return size_t Bytes allocated for slabs
+     */
+    size_t get_reserved_bytes() const noexcept;
+};
+
+/**
+ * @struct DescriptorDeleter
+ * @brief unique_ptr deleter returning objects to their pool
+ */
+struct DescriptorDeleter{
+    template<typename T>
+    void operator()(T* object) const noexcept { DescriptorPool::destroy(object); }
+};
+
+/**
+ * @brief Owning pointer to a pooled object
+ *
+ * @tparam T Object type
+ */
+template<typename T>
+using PooledPtr = std::unique_ptr<T, DescriptorDeleter>;
+
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef ELEMENTKEY_HPP
+#define ELEMENTKEY_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <Memory/IMemoryElement.hpp>
+#include <Memory/NameHash.hpp>
+#include <Memory/FlatTable.hpp>
+
+namespace MemoryNameSpace{
+
+/**
+ * @struct ElementKey
+ * @brief Composite key of a memory element: owning program and name
+ *
+ * The name hash is carried in the key, so hashing and rehashing never
+ * touch the name text.
+ */
+struct ElementKey{
+    ProgramId program = INVALID_PROGRAM_ID;  ///< Program whose namespace holds the element
+    std::string_view name;                   ///< Name of the element (interned storage)
+    size_t hash = 0;                         ///< Hash of the name
+};
+
+/**
+ * @struct ElementKeyHash
+ * @brief Hash functor combining the program id with the precomputed name hash
+ */
+struct ElementKeyHash{
+    size_t operator()(const ElementKey& key) const noexcept {
+        return key.hash ^ (static_cast<size_t>(key.program) * 0x9e3779b97f4a7c15ull);
+    }
+};
+
+/**
+ * @struct ElementKeyEqual
+ * @brief Equality functor for composite element keys
+ */
+struct ElementKeyEqual{
+    bool operator()(const ElementKey& lhs, const ElementKey& rhs) const noexcept {
+        return lhs.program == rhs.program && lhs.name == rhs.name;
+    }
+};
+
+/**
+ * @brief Flat hash map keyed by (program id, element name)
+ *
+ * @tparam T Mapped type
+ */
+template<typename T>
+using ElementMap = FlatTable<ElementKey, T, ElementKeyHash, ElementKeyEqual>;
+
+/**
+ * @brief Builds the key of an element in a program's namespace
+ *
+ * @param program Id of the program
+ * @param name Name of the element
+ * @return ElementKey Composite key
+ */
+inline ElementKey make_element_key(ProgramId program, std::string_view name) noexcept {
+    return ElementKey{program, name, hash_name(name)};
+}
+
+}
+
+#endif
@@ -0,0 +1,218 @@
+#ifndef ELEMENTTABLE_HPP
+#define ELEMENTTABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <Memory/IMemoryElement.hpp>
+
+namespace MemoryNameSpace{
+
+/**
+ * @class ElementTable
+ * @brief Struct-of-arrays storage for hot descriptor metadata
+ *
+ * Offsets, sizes, element sizes, kinds and owners of all memory elements
+ * live in parallel contiguous arrays indexed by ElementId. Descriptors
+ * keep only their id, so system-wide scans (used memory, statistics,
+ * defragmentation) stream through a few arrays instead of chasing
+ * descriptor pointers.
+ *
+ * Ids of erased elements are reused. A free slot has zero size and a
+ * null element pointer, so sums over sizes need no liveness check.
+ * References are not stored: they have no memory of their own.
+ *
+ * The table also counts pins held by views over element data. A pinned
+ * element must not be moved or destroyed.
+ */
+class ElementTable final{
+private:
+    std::vector<size_t> offsets_;             ///< Offsets in the memory buffer
+    std::vector<size_t> sizes_;               ///< Total sizes in bytes (0 for free slots)
+    std::vector<size_t> elem_sizes_;          ///< Sizes of individual elements in bytes
+    std::vector<ElementKind> kinds_;          ///< Kinds of the elements
+    std::vector<ProgramId> owners_;           ///< Programs that allocated the elements
+    std::vector<IMemoryElement*> elements_;   ///< Descriptors (nullptr for free slots)
+    std::vector<uint32_t> pins_;              ///< Number of live views per element
+    std::vector<ElementId> free_ids_;         ///< Ids available for reuse
+    size_t pinned_ = 0;                       ///< Total number of live views
+
+public:
+    /**
+     * @brief Constructs an empty table
+     */
+    ElementTable() = default;
+
+    ElementTable(const ElementTable&) = delete;
+    ElementTable& operator=(const ElementTable&) = delete;
+
+    /**
+     * @brief Registers an element and assigns it an id
+     *
+     * @param element Descriptor of the element
+     * @param kind Kind of the element
+     * @param offset Offset in the memory buffer
+     * @param size Total size in bytes
+     * @param elem_size Size of individual elements in bytes
+     * @return ElementId Id of the element
+     */
+    ElementId insert(IMemoryElement* element, ElementKind kind, size_t offset, size_t size, size_t elem_size);
+
+    /**
+     * @brief Releases the slot of an element
+     *
+     * @param id Id of the element
+     */
+    void erase(ElementId id) noexcept;
+
+    /**
+     * @brief Gets the offset of an element
+     *
+     * @param id Id of the element
+     * @return size_t Offset in the memory buffer
+     */
+    size_t get_offset(ElementId id) const noexcept { return offsets_[id]; }
+
+    /**
+     * @brief Sets the offset of an element
+     *
+     * @param id Id of the element
+     * @param offset New offset in the memory buffer
+     */
+    void set_offset(ElementId id, size_t offset) noexcept { offsets_[id] = offset; }
+
+    /**
+     * @brief Gets the total size of an element
+     *
+     * @param id Id of the element
+     * @return size_t Size in bytes
+     */
+    size_t get_size(ElementId id) const noexcept { return sizes_[id]; }
+
+    /**
+     * @brief Gets the size of individual elements
+     *
+     * @param id Id of the element
+     * @return size_t Element size in bytes
+     */
+    size_t get_elem_size(ElementId id) const noexcept { return elem_sizes_[id]; }
+
+    /**
+     * @brief Gets the kind of an element
+     *
+     * @param id Id of the element
+     * @return ElementKind Kind of the element
+     */
+    ElementKind get_kind(ElementId id) const noexcept { return kinds_[id]; }
+
+    /**
+     * @brief Gets the program that allocated an element
+     *
+     * @param id Id of the element
+     * @return ProgramId Owner id, or INVALID_PROGRAM_ID if not set
+     */
+    ProgramId get_owner(ElementId id) const noexcept { return owners_[id]; }
+
+    /**
+     * @brief Sets the program that allocated an element
+     *
+     * @param id Id of the element
+     * @param owner Owner id
+     */
+    void set_owner(ElementId id, ProgramId owner) noexcept { owners_[id] = owner; }
+
+    /**
+     * @brief Gets the descriptor of an element
+     *
+     * @param id Id of the element
+     * @return IMemoryElement* Descriptor, or nullptr for a free slot
+     */
+    IMemoryElement* get_element(ElementId id) const noexcept { return elements_[id]; }
+
+    /**
+     * @brief Pins an element so it can't be moved or destroyed
+     *
+     * @param id Id of the element
+     */
+    void pin(ElementId id) noexcept { ++pins_[id]; ++pinned_; }
+
+    /**
+     * @brief Releases a pin taken with pin()
+     *
+     * @param id Id of the element
+     */
+    void unpin(ElementId id) noexcept { --pins_[id]; --pinned_; }
+
+    /**
+     * @brief Checks whether an element is pinned
+     *
+     * @param id Id of the element
+     * @return true if at least one view of the element is alive
+     */
+    bool is_pinned(ElementId id) const noexcept { return pins_[id] != 0; }
+
+    /**
+     * @brief Gets the total number of pins
+     *
+     * @return size_t Number of live views over all elements
+     */
+    size_t get_pin_count() const noexcept { return pinned_; }
+
+    /**
+     * @brief Gets the number of slots, including free ones
+     *
+     * @return size_t Number of slots
+     */
+    size_t slot_count() const noexcept { return offsets_.size(); }
+
+    /**
+     * @brief Gets the number of registered elements
+     *
+     * @return size_t Number of live elements
+     */
+    size_t size() const noexcept { return offsets_.size() - free_ids_.size(); }
+
+    /**
+     * @brief Gets the offsets of all slots
+     */
+    std::span<const size_t> get_offsets() const noexcept { return offsets_; }
+
+    /**
+     * @brief Gets the sizes of all slots
+     */
+    std::span<const size_t> get_sizes() const noexcept { return sizes_; }
+
+    /**
+     * @brief Gets the element sizes of all slots
+     */
+    std::span<const size_t> get_elem_sizes() const noexcept { return elem_sizes_; }
+
+    /**
+     * @brief Gets the kinds of all slots
+     */
+    std::span<const ElementKind> get_kinds() const noexcept { return kinds_; }
+
+    /**
+     * @brief Gets the owners of all slots
+     */
+    std::span<const ProgramId> get_owners() const noexcept { return owners_; }
+
+    /**
+     * @brief Gets the total size of all registered elements
+     *
+     * @return size_t Used memory in bytes
+     */
+    size_t get_used_memory() const noexcept;
+
+    /**
+     * @brief Gets the ids of all registered elements ordered by offset
+     *
+     * @return std::vector<ElementId> Element ids sorted by offset
+     */
+    std::vector<ElementId> ids_by_offset() const;
+};
+
+}
+
+#endif
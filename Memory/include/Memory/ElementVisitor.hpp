@@ -0,0 +1,75 @@
+#ifndef ELEMENTVISITOR_HPP
+#define ELEMENTVISITOR_HPP
+
+#include <utility>
+#include <Memory/IMemoryElement.hpp>
+#include <Memory/VariableDescriptor.hpp>
+#include <Memory/ArrayDescriptor.hpp>
+#include <Memory/SharedSegmentDescriptor.hpp>
+#include <Memory/ReferenceDescriptor.hpp>
+
+namespace MemoryNameSpace{
+
+/**
+ * @brief Calls a visitor with the element cast to its concrete type
+ *
+ * Dispatch is a switch over the element kind, so the visitor is
+ * instantiated for each descriptor type and calls on final types
+ * can be devirtualized. The switch lists every kind without a
+ * default, so -Wswitch flags a kind added without a case here.
+ *
+ * @tparam Visitor Callable accepting VariableDescriptor&, ArrayDescriptor&,
+ *                 SharedSegmentDescriptor& and ReferenceDescriptor&
+ * @param element Element to visit
+ * @param visitor Visitor to call
+ * @return decltype(auto) Result of the visitor call
+ */
+template<typename Visitor>
+decltype(auto) visit_element(IMemoryElement& element, Visitor&& visitor){
+    switch(element.get_kind()){
+    case ElementKind::Variable:
+        return std::forward<Visitor>(visitor)(static_cast<VariableDescriptor&>(element));
+    case ElementKind::Array:
+        return std::forward<Visitor>(visitor)(static_cast<ArrayDescriptor&>(element));
+    case ElementKind::Shared:
+        return std::forward<Visitor>(visitor)(static_cast<SharedSegmentDescriptor&>(element));
+    case ElementKind::Reference:
+        return std::forward<Visitor>(visitor)(static_cast<ReferenceDescriptor&>(element));
+    }
+    std::unreachable();
+}
+
+/**
+ * @brief Calls a visitor with the element cast to its concrete type (const version)
+ *
+ * @tparam Visitor Callable accepting const references to every descriptor type
+ * @param element Element to visit
+ * @param visitor Visitor to call
+ * @return decltype(auto) Result of the visitor call
+ */
+template<typename Visitor>
+decltype(auto) visit_element(const IMemoryElement& element, Visitor&& visitor){
+    switch(element.get_kind()){
+    case ElementKind::Variable:
+        return std::forward<Visitor>(visitor)(static_cast<const VariableDescriptor&>(element));
+    case ElementKind::Array:
+        return std::forward<Visitor>(visitor)(static_cast<const ArrayDescriptor&>(element));
+    case ElementKind::Shared:
+        return std::forward<Visitor>(visitor)(static_cast<const SharedSegmentDescriptor&>(element));
+    case ElementKind::Reference:
+        return std::forward<Visitor>(visitor)(static_cast<const ReferenceDescriptor&>(element));
+    }
+    std::unreachable();
+}
+
+/**
+ * @brief Helper combining several lambdas into one overloaded visitor
+ */
+template<typename... Fs>
+struct Overloaded : Fs... {
+    using Fs::operator()...;
+};
+
+}
+
+#endif
@@ -3,6 +3,8 @@
 
 #include <string>
 #include <vector>
+#include <chrono>
+#include <utility>
 
 namespace MemoryNameSpace{
 
@@ -22,6 +24,19 @@ enum error_t {
     ACCESS_ERROR = 3,  ///< Access permission errors
 };
 
+/**
+ * @brief Number of error_t values
+ */
+constexpr size_t ERROR_TYPE_COUNT = 4;
+
+/**
+ * @brief Checks whether a number names an error_t value
+ *
+ * @param type Number to check
+ * @return true if type is one of the error_t values
+ */
+constexpr bool is_error_type(size_t type) noexcept { return type < ERROR_TYPE_COUNT; }
+
 /**
  * @class Error
  * @brief Represents an error in the memory management system
@@ -34,6 +49,9 @@ private:
     error_t type_;              ///< Type of error
     std::string description_;   ///< Error description
     std::string program_name_;  ///< Name of program where error occurred
+    std::chrono::steady_clock::time_point first_; ///< When the error first occurred
+    std::chrono::steady_clock::time_point last_;  ///< When the error last occurred
+    size_t count_;                                ///< Number of coalesced occurrences
 
 public:
     /**
@@ -42,9 +60,14 @@ public:
      * @param type Error type identifier
      * @param description Error description
      * @param program_name Name of program where error occurred
+     * @param first When the error first occurred
+     * @param last When the error last occurred
+     * @param count Number of coalesced occurrences
      */
-    Error(size_t type, std::string description, const std::string& program_name)
-            : type_(static_cast<error_t>(type)), description_(description), program_name_(program_name) {}
+    Error(size_t type, std::string description, const std::string& program_name,
+          std::chrono::steady_clock::time_point first = {}, std::chrono::steady_clock::time_point last = {}, size_t count = 1)
+            : type_(static_cast<error_t>(type)), description_(std::move(description)), program_name_(program_name),
+              first_(first), last_(last), count_(count) {}
     
     /**
      * @brief Gets the error description
@@ -59,6 +82,34 @@ public:
      * @return const std::string& Reference to program name
      */
     const std::string& get_program() const;
+
+    /**
+     * @brief Gets the error type
+     * 
+     * @return error_t Type of error
+     */
+    error_t get_type() const noexcept { return type_; }
+
+    /**
+     * @brief Gets the time the error first occurred
+     * 
+     * @return std::chrono::steady_clock::time_point Time of the first occurrence
+     */
+    std::chrono::steady_clock::time_point get_time() const noexcept { return first_; }
+
+    /**
+     * @brief Gets the time the error last occurred
+     * 
+     * @return std::chrono::steady_clock::time_point Time of the last occurrence
+     */
+    std::chrono::steady_clock::time_point get_last_time() const noexcept { return last_; }
+
+    /**
+     * @brief Gets the number of identical consecutive occurrences merged into this error
+     * 
+     * @return size_t Occurrence count
+     */
+    size_t get_count() const noexcept { return count_; }
 };
 
 }
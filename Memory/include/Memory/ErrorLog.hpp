@@ -0,0 +1,381 @@
+#ifndef ERRORLOG_HPP
+#define ERRORLOG_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <Memory/Error.hpp>
+#include <Memory/NameArena.hpp>
+
+namespace MemoryNameSpace{
+
+/**
+ * @enum ErrorCode
+ * @brief Kinds of messages stored in the error log
+ *
+ * Each code fixes the error type and the message template; the names and
+ * numbers substituted into the template are kept in the ErrorContext.
+ */
+enum class ErrorCode : uint8_t {
+    Custom,                 ///< Free text stored as the subject
+    BufferOverflow,         ///< No free block is large enough
+    InvalidBlock,           ///< Block [args[0], args[0] + args[1]) is outside the buffer
+    DoubleFree,             ///< Block is already free
+    AlreadyAllocated,       ///< Element subject already exists
+    AlreadyFreed,           ///< Element subject doesn't exist on free
+    ProgramNotFound,        ///< Program doesn't exist
+    ProgramExists,          ///< Program has already been added
+    ElementNotFound,        ///< Element subject doesn't exist
+    ElementNotAvailable,    ///< Element subject isn't available for the program
+    ElementPinned,          ///< Element subject is pinned by a view
+    ElementStillReachable,  ///< Element subject leaked by the program
+    NotSharedSegment,       ///< Element subject isn't a shared segment
+    ReferenceToReference,   ///< Reference to a reference was requested
+    MemoryLimitExceeded,    ///< Memory limit of program subject exceeded
+    SegmentAccessDenied,    ///< Program has no access to segment subject
+    SegmentInUse,           ///< Segment subject is used by other programs
+    LastSegmentOwner,       ///< Program is the last owner of segment subject
+    DefragmentationPinned,  ///< Defragmentation blocked by args[0] pins
+    RangeOutOfBounds,       ///< Range [args[0], args[1]) outside array subject of args[2] elements
+    ByteRangeOutOfBounds,   ///< Range [args[0], args[1]) outside variable subject of args[2] bytes
+    LengthMismatch          ///< Arrays subject and other have different lengths
+};
+
+/**
+ * @brief Numeric arguments of an error message
+ */
+using ErrorArgs = std::array<size_t, 3>;
+
+/**
+ * @struct ErrorContext
+ * @brief Values substituted into the message template of an error code
+ */
+struct ErrorContext{
+    std::string_view subject;  ///< Main element, segment or program name (or the text of a custom error)
+    std::string_view other;    ///< Second name, if the message has one
+    ErrorArgs args{};          ///< Numeric arguments
+
+    /**
+     * @brief Constructs a context without names or numbers
+     */
+    ErrorContext() = default;
+
+    /**
+     * @brief Constructs a context
+     *
+     * @param subject Main name of the message
+     * @param other Second name of the message
+     * @param args Numeric arguments
+     */
+    ErrorContext(std::string_view subject, std::string_view other = {}, ErrorArgs args = {})
+            : subject(subject), other(other), args(args) {}
+};
+
+/**
+ * @struct ErrorRecord
+ * @brief Compact entry of the error log
+ *
+ * Names are interned handles held by the record, so a record has a fixed
+ * size and stays readable after the program or element it mentions is
+ * gone. Identical consecutive errors of a program share one record with
+ * a count.
+ */
+struct ErrorRecord{
+    std::chrono::steady_clock::time_point first;  ///< When the error first occurred
+    std::chrono::steady_clock::time_point last;   ///< When the error last occurred
+    size_t count = 1;                             ///< Number of coalesced occurrences
+    ErrorArgs args{};                             ///< Numeric arguments
+    const InternedName* program = nullptr;        ///< Program where the error occurred
+    const InternedName* subject = nullptr;        ///< Main name of the message
+    const InternedName* other = nullptr;          ///< Second name of the message
+    uint64_t next_of_program = 0;                 ///< Sequence number of the next record of the same program
+    uint64_t next_of_type = 0;                    ///< Sequence number of the next record of the same type
+    ErrorCode code = ErrorCode::Custom;           ///< Message template
+    error_t type = SIZE_ERROR;                    ///< Error type
+};
+
+/**
+ * @struct ErrorRateLimit
+ * @brief Maximum number of new records a program may add per time window
+ */
+struct ErrorRateLimit{
+    size_t records = 0;                                ///< Records allowed per window (0 for no limit)
+    std::chrono::steady_clock::duration window{};      ///< Length of the window
+};
+
+/**
+ * @class ErrorLog
+ * @brief Bounded log of compact error records
+ *
+ * Records are kept in a ring buffer: once it is full, each new error
+ * replaces the oldest one. Messages are formatted only when errors are
+ * read. Records of the same program and of the same type are chained
+ * in recording order, so counts are O(1) and filtered queries visit
+ * only the matching records.
+ *
+ * An error identical to the last kept error of the same program only
+ * increments that record's count. New records beyond a program's rate
+ * limit are counted as suppressed and not stored, which bounds the work
+ * and memory a misbehaving program can cause.
+ *
+ * Names are released when the last record mentioning them is replaced,
+ * and a program's chain is dropped once none of its records are left
+ * (unless it has its own rate limit). Together with MAX_TEXT_LENGTH this
+ * bounds memory by the capacity rather than by the names ever seen. Per-program
+ * totals and suppression counts therefore cover only programs that
+ * still have records or a rate limit.
+ */
+class ErrorLog final{
+private:
+    /**
+     * @struct Chain
+     * @brief Records of one program or one type still in the ring
+     */
+    struct Chain{
+        uint64_t head = 0;   ///< Sequence number of the oldest record
+        uint64_t tail = 0;   ///< Sequence number of the newest record
+        size_t live = 0;     ///< Number of records in the ring
+        size_t total = 0;    ///< Number of errors ever reported
+    };
+
+    /**
+     * @struct ProgramChain
+     * @brief Records and rate limit state of one program
+     */
+    struct ProgramChain : Chain{
+        ErrorRateLimit limit;                                  ///< Own rate limit
+        bool has_limit = false;                                ///< Whether limit overrides the default
+        std::chrono::steady_clock::time_point window_start;   ///< Start of the current window
+        size_t window_records = 0;                             ///< New records in the current window
+        size_t suppressed = 0;                                 ///< Errors dropped by the rate limit
+    };
+
+    std::vector<ErrorRecord> ring_;                                 ///< Records indexed by sequence number modulo capacity
+    size_t capacity_;                                               ///< Maximum number of kept records
+    uint64_t next_ = 0;                                             ///< Sequence number of the next record
+    NameArena names_;                                               ///< Interned program and element names
+    std::unordered_map<const InternedName*, ProgramChain> by_program_; ///< Chains of records per program
+    std::array<Chain, ERROR_TYPE_COUNT> by_type_{};                 ///< Chains of records per error type
+    ErrorRateLimit default_limit_ = DEFAULT_RATE_LIMIT;             ///< Rate limit of programs without their own
+    size_t suppressed_ = 0;                                         ///< Errors dropped by rate limits
+
+    /**
+     * @brief Gets the record with a sequence number
+     */
+    const ErrorRecord& at(uint64_t sequence) const noexcept { return ring_[sequence % capacity_]; }
+
+    /**
+     * @brief Gets the chain of a program, creating it if needed
+     */
+    ProgramChain& chain_of(std::string_view program);
+
+    /**
+     * @brief Drops the chain of a program if nothing refers to it anymore
+     */
+    void drop_if_unused(std::unordered_map<const InternedName*, ProgramChain>::iterator chain) noexcept;
+
+    /**
+     * @brief Removes the oldest record from its chains and releases its names
+     *
+     * @param current Chain of the record being added, which is kept even if it empties
+     */
+    void evict_oldest(const ProgramChain& current) noexcept;
+
+    /**
+     * @brief Merges an error into the last record of its program if they are identical
+     *
+     * @return true if the error was merged
+     */
+    bool coalesce(const ProgramChain& chain, ErrorCode code, error_t type, const ErrorContext& context,
+                  std::chrono::steady_clock::time_point now) noexcept;
+
+    /**
+     * @brief Counts a new record against the rate limit of its program
+     *
+     * @return true if the record may be stored
+     */
+    bool admit(ProgramChain& chain, std::chrono::steady_clock::time_point now) noexcept;
+
+    /**
+     * @brief Appends a record to a chain
+     */
+    void link(Chain& chain, uint64_t sequence, uint64_t ErrorRecord::* next) noexcept;
+
+    /**
+     * @brief Collects the records of a chain as formatted errors
+     */
+    std::vector<Error> collect(const Chain& chain, uint64_t ErrorRecord::* next) const;
+
+    /**
+     * @brief Stores a record in the ring
+     */
+    void push(ErrorCode code, error_t type, std::string_view program, const ErrorContext& context);
+
+public:
+    /**
+     * @brief Default maximum number of kept records
+     */
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 12;
+
+    /**
+     * @brief Default rate limit of programs without their own
+     *
+     * A single program can't fill more than a sixteenth of the default
+     * ring per second.
+     */
+    static constexpr ErrorRateLimit DEFAULT_RATE_LIMIT{DEFAULT_CAPACITY / 16, std::chrono::seconds(1)};
+
+    /**
+     * @brief Maximum length of a stored name or description in bytes
+     *
+     * Longer texts are cut, so a record never costs more than a few
+     * names of this length.
+     */
+    static constexpr size_t MAX_TEXT_LENGTH = 256;
+
+    /**
+     * @brief Constructs an empty log
+     *
+     * @param capacity Maximum number of kept records (at least 1)
+     */
+    explicit ErrorLog(size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Records an error with a message template
+     *
+     * @param code Message template, which also fixes the error type
+     * @param program Name of program where the error occurred
+     * @param context Names and numbers substituted into the template
+     */
+    void record(ErrorCode code, std::string_view program, const ErrorContext& context);
+
+    /**
+     * @brief Records an error with free text
+     *
+     * @param type Error type
+     * @param description Error description
+     * @param program Name of program where the error occurred
+     * @throws std::out_of_range If type isn't an error_t value
+     */
+    void record_text(error_t type, std::string_view description, std::string_view program);
+
+    /**
+     * @brief Formats the message of a record
+     *
+     * @param record Record to format
+     * @return std::string Error description without the type and program prefix
+     */
+    static std::string format(const ErrorRecord& record);
+
+    /**
+     * @brief Gets the error type of a message template
+     *
+     * @param code Message template
+     * @return error_t Error type
+     */
+    static error_t type_of(ErrorCode code) noexcept;
+
+    /**
+     * @brief Gets all kept errors, oldest first
+     *
+     * @return std::vector<Error> Formatted errors
+     */
+    std::vector<Error> all() const;
+
+    /**
+     * @brief Gets the kept errors of a program, oldest first
+     *
+     * @param program Name of the program
+     * @return std::vector<Error> Formatted errors
+     */
+    std::vector<Error> by_program(std::string_view program) const;
+
+    /**
+     * @brief Gets the kept errors of a type, oldest first
+     *
+     * @param type Error type
+     * @return std::vector<Error> Formatted errors (none for an invalid type)
+     */
+    std::vector<Error> by_type(error_t type) const;
+
+    /**
+     * @brief Gets the number of kept errors of a program
+     *
+     * @param program Name of the program
+     * @return size_t Number of errors in the log
+     */
+    size_t count(std::string_view program) const;
+
+    /**
+     * @brief Gets the number of kept errors of a type
+     *
+     * @param type Error type
+     * @return size_t Number of errors in the log (0 for an invalid type)
+     */
+    size_t count(error_t type) const noexcept { return is_error_type(type) ? by_type_[type].live : 0; }
+
+    /**
+     * @brief Gets the number of errors of a type ever reported
+     *
+     * @param type Error type
+     * @return size_t Number of errors including coalesced, replaced and suppressed ones (0 for an invalid type)
+     */
+    size_t total(error_t type) const noexcept { return is_error_type(type) ? by_type_[type].total : 0; }
+
+    /**
+     * @brief Gets the number of kept errors
+     */
+    size_t size() const noexcept { return ring_.size(); }
+
+    /**
+     * @brief Gets the maximum number of kept errors
+     */
+    size_t capacity() const noexcept { return capacity_; }
+
+    /**
+     * @brief Gets the number of distinct names held by kept records and program chains
+     */
+    size_t name_count() const noexcept { return names_.size(); }
+
+    /**
+     * @brief Gets the number of errors replaced by newer ones
+     */
+    size_t dropped() const noexcept { return next_ - ring_.size(); }
+
+    /**
+     * @brief Sets the rate limit of programs without their own limit
+     *
+     * @param limit Records allowed per window
+     */
+    void set_rate_limit(ErrorRateLimit limit) noexcept { default_limit_ = limit; }
+
+    /**
+     * @brief Sets the rate limit of a program
+     *
+     * @param program Name of the program
+     * @param limit Records allowed per window
+     */
+    void set_rate_limit(std::string_view program, ErrorRateLimit limit);
+
+    /**
+     * @brief Gets the number of errors dropped by rate limits
+     */
+    size_t suppressed() const noexcept { return suppressed_; }
+
+    /**
+     * @brief Gets the number of errors of a program dropped by its rate limit
+     *
+     * @param program Name of the program
+     * @return size_t Number of suppressed errors
+     */
+    size_t suppressed(std::string_view program) const;
+};
+
+}
+
+#endif
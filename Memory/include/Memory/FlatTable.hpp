@@ -0,0 +1,519 @@
+#ifndef FLATTABLE_HPP
+#define FLATTABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <algorithm>
+#include <new>
+#include <tuple>
+#include <utility>
+#include <iterator>
+#include <functional>
+#include <type_traits>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace MemoryNameSpace{
+
+/**
+ * @class FlatTable
+ * @brief Open-addressing hash table with Swiss-table style control bytes
+ *
+ * Slots are stored in one contiguous array next to an array of control
+ * bytes. Each control byte is either EMPTY, DELETED or the low 7 bits of
+ * the hash of the key stored in the slot. Lookups probe groups of 16
+ * control bytes at once (with SSE2 when available) and compare keys only
+ * for slots whose control byte matches.
+ *
+ * Unlike std::unordered_map, values are relocated when the table grows,
+ * so pointers and references to stored pairs are invalidated by inserts.
+ *
+ * @tparam K Key type
+ * @tparam V Mapped type
+ * @tparam Hash Hasher (may be transparent)
+ * @tparam KeyEqual Key equality (may be transparent)
+ */
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class FlatTable final{
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+    using size_type = size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+private:
+    using ctrl_t = int8_t;
+
+    static constexpr ctrl_t EMPTY = -128;       ///< Slot was never used since the last rehash
+    static constexpr ctrl_t DELETED = -2;       ///< Slot held an element that was erased
+    static constexpr ctrl_t SENTINEL = -1;      ///< Marks the end of the control array for iteration
+    static constexpr size_t GROUP_WIDTH = 16;   ///< Number of control bytes probed at once
+
+    /**
+     * @struct Group
+     * @brief Window over GROUP_WIDTH control bytes
+     *
+     * Every match function returns a bitmask with bit i set
+     * when control byte i of the group satisfies the condition.
+     */
+    struct Group{
+#if defined(__SSE2__)
+        __m128i ctrl; ///< Loaded control bytes
+
+        explicit Group(const ctrl_t* pos) noexcept
+                : ctrl(_mm_load_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+        uint32_t match(ctrl_t h2) const noexcept {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+        }
+
+        uint32_t match_empty() const noexcept {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(EMPTY), ctrl)));
+        }
+
+        uint32_t match_empty_or_deleted() const noexcept {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(SENTINEL), ctrl)));
+        }
+#else
+        const ctrl_t* ctrl; ///< First control byte of the group
+
+        explicit Group(const ctrl_t* pos) noexcept : ctrl(pos) {}
+
+        uint32_t match(ctrl_t h2) const noexcept {
+            uint32_t mask = 0;
+            for(size_t i = 0; i < GROUP_WIDTH; ++i)
+                mask |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+            return mask;
+        }
+
+        uint32_t match_empty() const noexcept { return match(EMPTY); }
+
+        uint32_t match_empty_or_deleted() const noexcept {
+            uint32_t mask = 0;
+            for(size_t i = 0; i < GROUP_WIDTH; ++i)
+                mask |= static_cast<uint32_t>(ctrl[i] < SENTINEL) << i;
+            return mask;
+        }
+#endif
+    };
+
+    /**
+     * @class Iterator
+     * @brief Forward iterator over occupied slots
+     *
+     * @tparam Const Whether the iterator gives const access
+     */
+    template<bool Const>
+    class Iterator{
+        friend class FlatTable;
+        friend class Iterator<!Const>;
+        using slot_ptr = std::conditional_t<Const, const std::pair<const K, V>*, std::pair<const K, V>*>;
+
+        const ctrl_t* ctrl_ = nullptr; ///< Current control byte
+        slot_ptr slot_ = nullptr;      ///< Current slot
+
+        Iterator(const ctrl_t* ctrl, slot_ptr slot) noexcept : ctrl_(ctrl), slot_(slot) {}
+
+        void skip_free() noexcept {
+            while(*ctrl_ < SENTINEL){
+                ++ctrl_;
+                ++slot_;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename FlatTable::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer = slot_ptr;
+
+        Iterator() = default;
+
+        operator Iterator<true>() const noexcept requires (!Const) { return Iterator<true>{ctrl_, slot_}; }
+
+        reference operator*() const noexcept { return *slot_; }
+        pointer operator->() const noexcept { return slot_; }
+
+        Iterator& operator++() noexcept {
+            ++ctrl_;
+            ++slot_;
+            skip_free();
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept { return lhs.ctrl_ == rhs.ctrl_; }
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+private:
+    ctrl_t* ctrl_ = nullptr;       ///< Control bytes, capacity_ + GROUP_WIDTH entries
+    value_type* slots_ = nullptr;  ///< Slot storage, capacity_ entries
+    size_t capacity_ = 0;          ///< Number of slots (power of two, multiple of GROUP_WIDTH)
+    size_t size_ = 0;              ///< Number of occupied slots
+    size_t deleted_ = 0;           ///< Number of DELETED control bytes
+    [[no_unique_address]] Hash hash_;
+    [[no_unique_address]] KeyEqual equal_;
+
+private:
+    /**
+     * @brief Spreads hasher output over all bits
+     *
+     * Identity hashes (e.g. for pointers) have poor low bits,
+     * which would otherwise end up in the control bytes.
+     */
+    static size_t mix(size_t hash) noexcept {
+        uint64_t value = hash;
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        return static_cast<size_t>(value);
+    }
+
+    static ctrl_t h2(size_t hash) noexcept { return static_cast<ctrl_t>(hash & 0x7F); }
+
+    static size_t h1(size_t hash) noexcept { return hash >> 7; }
+
+    static ctrl_t* allocate_ctrl(size_t capacity){
+        ctrl_t* ctrl = static_cast<ctrl_t*>(::operator new(capacity + GROUP_WIDTH, std::align_val_t{GROUP_WIDTH}));
+        std::memset(ctrl, EMPTY, capacity);
+        std::memset(ctrl + capacity, SENTINEL, GROUP_WIDTH);
+        return ctrl;
+    }
+
+    static value_type* allocate_slots(size_t capacity){
+        return static_cast<value_type*>(::operator new(capacity * sizeof(value_type), std::align_val_t{alignof(value_type)}));
+    }
+
+    void destroy_slots() noexcept {
+        for(size_t i = 0; i < capacity_; ++i){
+            if(ctrl_[i] >= 0) slots_[i].~value_type();
+        }
+    }
+
+    void deallocate() noexcept {
+        if(capacity_ == 0) return;
+        ::operator delete(ctrl_, std::align_val_t{GROUP_WIDTH});
+        ::operator delete(slots_, std::align_val_t{alignof(value_type)});
+        ctrl_ = nullptr;
+        slots_ = nullptr;
+        capacity_ = 0;
+    }
+
+    /**
+     * @brief Finds the slot holding a key
+     *
+     * @param key Key to look for
+     * @param hash Mixed hash of the key
+     * @return size_t Slot index, or capacity_ if not found
+     */
+    template<typename KeyArg>
+    size_t find_index(const KeyArg& key, size_t hash) const {
+        if(capacity_ == 0) return capacity_;
+        const size_t group_mask = capacity_ / GROUP_WIDTH - 1;
+        size_t group = h1(hash) & group_mask;
+        for(size_t step = 1; step <= group_mask + 1; ++step){
+            Group window(ctrl_ + group * GROUP_WIDTH);
+            for(uint32_t mask = window.match(h2(hash)); mask != 0; mask &= mask - 1){
+                size_t index = group * GROUP_WIDTH + static_cast<size_t>(std::countr_zero(mask));
+                if(equal_(slots_[index].first, key)) return index;
+            }
+            if(window.match_empty() != 0) return capacity_;
+            group = (group + step) & group_mask;
+        }
+        return capacity_;
+    }
+
+    /**
+     * @brief Finds the first EMPTY or DELETED slot on the probe sequence
+     *
+     * @param ctrl Control bytes to search
+     * @param capacity Number of slots
+     * @param hash Mixed hash of the key
+     * @return size_t Slot index
+     */
+    static size_t find_free(const ctrl_t* ctrl, size_t capacity, size_t hash) noexcept {
+        const size_t group_mask = capacity / GROUP_WIDTH - 1;
+        size_t group = h1(hash) & group_mask;
+        for(size_t step = 1; ; ++step){
+            uint32_t mask = Group(ctrl + group * GROUP_WIDTH).match_empty_or_deleted();
+            if(mask != 0) return group * GROUP_WIDTH + static_cast<size_t>(std::countr_zero(mask));
+            group = (group + step) & group_mask;
+        }
+    }
+
+    /**
+     * @brief Moves all elements into freshly allocated storage
+     *
+     * @param capacity New number of slots
+     */
+    void rehash(size_t capacity){
+        ctrl_t* ctrl = allocate_ctrl(capacity);
+        value_type* slots = allocate_slots(capacity);
+        for(size_t i = 0; i < capacity_; ++i){
+            if(ctrl_[i] < 0) continue;
+            size_t hash = mix(hash_(slots_[i].first));
+            size_t index = find_free(ctrl, capacity, hash);
+            ::new(slots + index) value_type(std::move(slots_[i]));
+            ctrl[index] = h2(hash);
+            slots_[i].~value_type();
+        }
+        deallocate();
+        ctrl_ = ctrl;
+        slots_ = slots;
+        capacity_ = capacity;
+        deleted_ = 0;
+    }
+
+    /**
+     * @brief Makes room for one more element, growing or purging DELETED slots
+     */
+    void prepare_insert(){
+        if((size_ + deleted_ + 1) * 8 <= capacity_ * 7) return;
+        if((size_ + 1) * 16 > capacity_ * 7) rehash(capacity_ == 0 ? GROUP_WIDTH : capacity_ * 2);
+        else rehash(capacity_);
+    }
+
+    void erase_at(size_t index) noexcept {
+        slots_[index].~value_type();
+        size_t group = index / GROUP_WIDTH * GROUP_WIDTH;
+        // A group that still has an EMPTY slot has never been full,
+        // so no probe sequence continues past it.
+        if(Group(ctrl_ + group).match_empty() != 0) ctrl_[index] = EMPTY;
+        else{
+            ctrl_[index] = DELETED;
+            ++deleted_;
+        }
+        --size_;
+    }
+
+    iterator iterator_at(size_t index) noexcept { return iterator{ctrl_ + index, slots_ + index}; }
+
+    const_iterator iterator_at(size_t index) const noexcept { return const_iterator{ctrl_ + index, slots_ + index}; }
+
+public:
+    /**
+     * @brief Constructs an empty table without allocating
+     */
+    FlatTable() = default;
+
+    /**
+     * @brief Copy-constructs a table with the same capacity
+     */
+    FlatTable(const FlatTable& other) : size_(other.size_), hash_(other.hash_), equal_(other.equal_) {
+        if(other.capacity_ == 0) return;
+        ctrl_ = allocate_ctrl(other.capacity_);
+        slots_ = allocate_slots(other.capacity_);
+        capacity_ = other.capacity_;
+        deleted_ = other.deleted_;
+        std::memcpy(ctrl_, other.ctrl_, capacity_);
+        for(size_t i = 0; i < capacity_; ++i){
+            if(ctrl_[i] >= 0) ::new(slots_ + i) value_type(other.slots_[i]);
+        }
+    }
+
+    /**
+     * @brief Move-constructs a table, leaving the source empty
+     */
+    FlatTable(FlatTable&& other) noexcept
+            : ctrl_(std::exchange(other.ctrl_, nullptr)), slots_(std::exchange(other.slots_, nullptr))
+            , capacity_(std::exchange(other.capacity_, 0)), size_(std::exchange(other.size_, 0))
+            , deleted_(std::exchange(other.deleted_, 0)), hash_(other.hash_), equal_(other.equal_) {}
+
+    FlatTable& operator=(FlatTable other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~FlatTable(){
+        destroy_slots();
+        deallocate();
+    }
+
+    void swap(FlatTable& other) noexcept {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(deleted_, other.deleted_);
+        std::swap(hash_, other.hash_);
+        std::swap(equal_, other.equal_);
+    }
+
+    iterator begin() noexcept {
+        if(capacity_ == 0) return end();
+        iterator it{ctrl_, slots_};
+        it.skip_free();
+        return it;
+    }
+
+    const_iterator begin() const noexcept {
+        if(capacity_ == 0) return end();
+        const_iterator it{ctrl_, slots_};
+        it.skip_free();
+        return it;
+    }
+
+    iterator end() noexcept { return iterator_at(capacity_); }
+
+    const_iterator end() const noexcept { return iterator_at(capacity_); }
+
+    size_t size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    /**
+     * @brief Gets the number of slots
+     *
+     * @return size_t Number of allocated slots
+     */
+    size_t capacity() const noexcept { return capacity_; }
+
+    /**
+     * @brief Gets the element stored in a slot
+     *
+     * Slots can be visited by index in [0, capacity()), which lets a scan
+     * be split into independent subranges.
+     *
+     * @param index Slot index, less than capacity()
+     * @return const value_type* Stored element, or nullptr if the slot is free
+     */
+    const value_type* slot(size_t index) const noexcept {
+        return ctrl_[index] >= 0 ? slots_ + index : nullptr;
+    }
+
+    /**
+     * @brief Gets the heap memory used by the table
+     *
+     * @return size_t Bytes allocated for slots and control bytes
+     */
+    size_t get_memory_usage() const noexcept {
+        if(capacity_ == 0) return 0;
+        return capacity_ * sizeof(value_type) + capacity_ + GROUP_WIDTH;
+    }
+
+    /**
+     * @brief Ensures the table can hold count elements without growing
+     *
+     * @param count Expected number of elements
+     */
+    void reserve(size_t count){
+        size_t capacity = std::bit_ceil(std::max(GROUP_WIDTH, count * 8 / 7 + 1));
+        if(capacity > capacity_) rehash(capacity);
+    }
+
+    /**
+     * @brief Removes all elements, keeping the allocated slots
+     */
+    void clear() noexcept {
+        destroy_slots();
+        if(capacity_ != 0) std::memset(ctrl_, EMPTY, capacity_);
+        size_ = 0;
+        deleted_ = 0;
+    }
+
+    /**
+     * @brief Finds an element by key
+     *
+     * @param key Key or any type accepted by the transparent hasher
+     * @return iterator Iterator to the element, or end() if not found
+     */
+    template<typename KeyArg>
+    iterator find(const KeyArg& key){
+        return iterator_at(find_index(key, mix(hash_(key))));
+    }
+
+    template<typename KeyArg>
+    const_iterator find(const KeyArg& key) const {
+        return iterator_at(find_index(key, mix(hash_(key))));
+    }
+
+    template<typename KeyArg>
+    bool contains(const KeyArg& key) const { return find(key) != end(); }
+
+    /**
+     * @brief Inserts an element using a hash computed by the caller
+     *
+     * @param hash Hasher output for the key
+     * @param key Key (converted to K only if inserted)
+     * @param args Arguments for constructing the mapped value
+     * @return std::pair<iterator, bool> Iterator to the element and whether it was inserted
+     */
+    template<typename KeyArg, typename... Args>
+    std::pair<iterator, bool> try_emplace_hashed(size_t hash, KeyArg&& key, Args&&... args){
+        hash = mix(hash);
+        size_t index = find_index(key, hash);
+        if(index != capacity_) return {iterator_at(index), false};
+        prepare_insert();
+        index = find_free(ctrl_, capacity_, hash);
+        ::new(slots_ + index) value_type(std::piecewise_construct,
+                                         std::forward_as_tuple(std::forward<KeyArg>(key)),
+                                         std::forward_as_tuple(std::forward<Args>(args)...));
+        if(ctrl_[index] == DELETED) --deleted_;
+        ctrl_[index] = h2(hash);
+        ++size_;
+        return {iterator_at(index), true};
+    }
+
+    /**
+     * @brief Inserts an element if the key is not present
+     *
+     * @param key Key (converted to K only if inserted)
+     * @param args Arguments for constructing the mapped value
+     * @return std::pair<iterator, bool> Iterator to the element and whether it was inserted
+     */
+    template<typename KeyArg, typename... Args>
+    std::pair<iterator, bool> try_emplace(KeyArg&& key, Args&&... args){
+        size_t hash = hash_(key);
+        return try_emplace_hashed(hash, std::forward<KeyArg>(key), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Erases the element at the iterator
+     *
+     * @param pos Iterator to an existing element
+     * @return iterator Iterator to the next element
+     */
+    iterator erase(const_iterator pos) noexcept {
+        size_t index = static_cast<size_t>(pos.ctrl_ - ctrl_);
+        erase_at(index);
+        iterator it = iterator_at(index);
+        it.skip_free();
+        return it;
+    }
+
+    iterator erase(iterator pos) noexcept { return erase(const_iterator{pos}); }
+
+    /**
+     * @brief Erases an element by key
+     *
+     * @param key Key or any type accepted by the transparent hasher
+     * @return size_t Number of erased elements (0 or 1)
+     */
+    template<typename KeyArg>
+        requires (!std::is_convertible_v<const KeyArg&, const_iterator>)
+    size_t erase(const KeyArg& key){
+        size_t index = find_index(key, mix(hash_(key)));
+        if(index == capacity_) return 0;
+        erase_at(index);
+        return 1;
+    }
+};
+
+}
+
+#endif
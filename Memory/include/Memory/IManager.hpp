@@ -4,10 +4,19 @@
 #include <memory>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <optional>
+#include <expected>
+#include <tuple>
+#include <type_traits>
 #include <Memory/Buffer.hpp>
 #include <Memory/IMemoryElement.hpp>
 #include <Memory/Error.hpp>
+#include <Memory/ErrorLog.hpp>
+#include <Memory/DescriptorPool.hpp>
+#include <Memory/NameArena.hpp>
+#include <Memory/ElementTable.hpp>
+#include <Memory/MemoryStats.hpp>
 
 namespace MemoryNameSpace{
 
@@ -21,6 +30,11 @@ class ReferenceDescriptor;
  */
 class IMemoryElement; 
 
+/**
+ * @brief Forward declaration of TraceRecorder class
+ */
+class TraceRecorder;
+
 /**
  * @concept memory_element_t
  * @brief Concept for valid memory element descriptors
@@ -43,14 +57,41 @@ concept memory_element_t =
  */
 class IManager {
 protected:
+    /**
+     * @brief Type-erased callback invoked for each program
+     */
+    using ProgramCallback = void (*)(void* context, Program& program);
+
+    /**
+     * @brief Type-erased callback invoked for each memory element
+     */
+    using ElementCallback = void (*)(void* context, IMemoryElement& element);
+
+    /**
+     * @brief Invokes a callback for each registered program
+     * 
+     * @param callback Callback to invoke
+     * @param context Opaque pointer passed to the callback
+     */
+    virtual void visit_programs(ProgramCallback callback, void* context) const = 0;
+
+    /**
+     * @brief Invokes a callback for each memory element
+     * 
+     * @param callback Callback to invoke
+     * @param context Opaque pointer passed to the callback
+     */
+    virtual void visit_elements(ElementCallback callback, void* context) const = 0;
+
     /**
      * @brief Validates and performs memory allocation
      * 
      * @param size Size to allocate in bytes
+     * @param alignment Required alignment of the offset
      * @param program Program requesting allocation
-     * @return std::optional<size_t> Offset of allocated block, or nullopt on failure
+     * @return std::expected<size_t, BufferError> Offset of allocated block, or the failure reason (error recorded)
      */
-    virtual std::optional<size_t> valid_allocate(size_t size, const Program& program) = 0;
+    virtual std::expected<size_t, BufferError> valid_allocate(size_t size, size_t alignment, const Program& program) = 0;
     
     /**
      * @brief Validates and performs memory destruction
@@ -58,20 +99,21 @@ protected:
      * @param offset Offset of block to destroy
      * @param size Size of block to destroy
      * @param program Program requesting destruction
-     * @return true if destruction successful
-     * @return false if destruction failed
+     * @return std::expected<void, BufferError> Nothing, or the failure reason (error recorded)
      */
-    virtual bool valid_destroy(size_t offset, size_t size, const Program& program) = 0;
+    virtual std::expected<void, BufferError> valid_destroy(size_t offset, size_t size, const Program& program) = 0;
     
     /**
      * @brief Checks if element exists and records allocation error if it does
      * 
      * @param name Name of element to check
      * @param program Program making the request
-     * @return true if element exists (error recorded)
+     * @param publish Whether the element will be published in the segment directory
+     * @return true if the name is taken in the program's namespace or, for published
+     *         elements, in the segment directory (error recorded)
      * @return false if element doesn't exist
      */
-    virtual bool check_exist_with_allocate_error(const std::string& name, const Program& program) = 0;
+    virtual bool check_exist_with_allocate_error(const std::string& name, const Program& program, bool publish) = 0;
     
     /**
      * @brief Checks if element exists and records destruction error if it doesn't
@@ -82,21 +124,31 @@ protected:
      * @return false if element exists
      */
     virtual bool check_exist_with_destroy_error(const std::string& name, const Program& program) = 0;
+
+    /**
+     * @brief Inserts a newly allocated element and records its owner
+     * 
+     * @param element Pointer to the allocated memory element
+     * @param program Program that allocated the element
+     */
+    virtual void register_element(IMemoryElement* element, const Program& program) = 0;
     
 public:
     /**
-     * @brief Inserts a memory element into the manager
+     * @brief Hands a newly created element to the program that owns it
      * 
      * @param element Pointer to memory element to insert
+     * @param program Program that created the element
      */
-    virtual void insert_element(IMemoryElement* element) = 0;
+    virtual void insert_element(IMemoryElement* element, const Program& program) = 0;
     
     /**
-     * @brief Erases a memory element from the manager
+     * @brief Destroys an element owned by a program
      * 
      * @param element Pointer to memory element to erase
+     * @param program Program that owns the element
      */
-    virtual void erase_element(IMemoryElement* element) = 0;
+    virtual void erase_element(IMemoryElement* element, const Program& program) = 0;
     
     /**
      * @brief Creates a reference to another memory element
@@ -141,8 +193,20 @@ public:
      * @param type Error type identifier
      * @param description Error description
      * @param program Name of program where error occurred
+     * @throws std::out_of_range If type isn't an error_t value
      */
     virtual void record_error(size_t type, const std::string& description, const std::string& program) = 0;
+
+    /**
+     * @brief Records an error with a message template
+     * 
+     * The message is formatted only when the error is read.
+     * 
+     * @param code Message template, which also fixes the error type
+     * @param program Name of program where error occurred
+     * @param context Names and numbers substituted into the template
+     */
+    virtual void record_error(ErrorCode code, std::string_view program, const ErrorContext& context) = 0;
     
     /**
      * @brief Grants access to a shared segment for a program
@@ -165,12 +229,12 @@ public:
     virtual bool revoke_access_to_shared(const std::string& prog_name, const std::string& segment_name) = 0;
 
     /**
-     * @brief Gets a memory element by name
+     * @brief Gets a shared segment by name
      * 
      * @param target_name Name of element to retrieve
      * @return IMemoryElement* Pointer to memory element, or nullptr if not found
      */
-    virtual IMemoryElement* get_element(const std::string& target_name) const = 0;
+    virtual IMemoryElement* get_element(std::string_view target_name) const = 0;
     
     /**
      * @brief Gets all registered programs
@@ -178,6 +242,83 @@ public:
      * @return std::unordered_map<std::string, Program*> Map of program names to pointers
      */
     virtual std::unordered_map<std::string, Program*> get_programs() const = 0;
+
+    /**
+     * @brief Finds a registered program without copying the program table
+     * 
+     * @param name Name of the program
+     * @return Program* Pointer to the program, or nullptr if not found
+     */
+    virtual Program* find_program(std::string_view name) const = 0;
+
+    /**
+     * @brief Finds a registered program by id
+     *
+     * Ids are dense and reused after delete_program, so the lookup is
+     * an index into the program registry.
+     *
+     * @param id Id of the program
+     * @return Program* Pointer to the program, or nullptr if the id is free
+     */
+    virtual Program* find_program(ProgramId id) const noexcept = 0;
+
+    /**
+     * @brief Finds a shared segment by name
+     * 
+     * Names are unique only within a program, so only segments can be
+     * found without naming the program.
+     * 
+     * @param name Name of the segment
+     * @return IMemoryElement* Pointer to the segment, or nullptr if not found
+     */
+    virtual IMemoryElement* find_element(std::string_view name) const = 0;
+
+    /**
+     * @brief Finds a memory element in the namespace of a program
+     * 
+     * @param program Name of the program
+     * @param name Name of the element
+     * @return IMemoryElement* Pointer to the element, or nullptr if not found
+     */
+    virtual IMemoryElement* find_element(std::string_view program, std::string_view name) const = 0;
+
+    /**
+     * @brief Gets the number of registered programs
+     * 
+     * @return size_t Number of programs
+     */
+    virtual size_t program_count() const noexcept = 0;
+
+    /**
+     * @brief Gets the number of memory elements
+     * 
+     * @return size_t Number of elements, including references
+     */
+    virtual size_t element_count() const noexcept = 0;
+
+    /**
+     * @brief Invokes a function for each registered program
+     * 
+     * @param function Callable invoked as function(Program&)
+     */
+    template<typename F>
+    void for_each_program(F&& function) const {
+        visit_programs([](void* context, Program& program){
+            (*static_cast<std::remove_reference_t<F>*>(context))(program);
+        }, const_cast<void*>(static_cast<const void*>(std::addressof(function))));
+    }
+
+    /**
+     * @brief Invokes a function for each memory element
+     * 
+     * @param function Callable invoked as function(IMemoryElement&)
+     */
+    template<typename F>
+    void for_each_element(F&& function) const {
+        visit_elements([](void* context, IMemoryElement& element){
+            (*static_cast<std::remove_reference_t<F>*>(context))(element);
+        }, const_cast<void*>(static_cast<const void*>(std::addressof(function))));
+    }
     
     /**
      * @brief Gets raw data buffer pointer
@@ -207,6 +348,42 @@ public:
      */
     virtual std::unordered_map<std::string, IMemoryElement*> get_memory_elements() const = 0;
 
+    /**
+     * @brief Gets the stored copy of a name, interning it if needed
+     * 
+     * @param name Name to intern
+     * @return const InternedName& Interned name with its hash
+     */
+    virtual const InternedName& intern_name(std::string_view name) = 0;
+
+    /**
+     * @brief Gives back a name taken with intern_name
+     * 
+     * @param name Interned name no longer held by the caller
+     */
+    virtual void release_name(const InternedName& name) noexcept = 0;
+
+    /**
+     * @brief Gets the pool used to allocate descriptors
+     * 
+     * @return DescriptorPool& Descriptor pool of the manager
+     */
+    virtual DescriptorPool& get_descriptor_pool() noexcept = 0;
+
+    /**
+     * @brief Gets the table with metadata of all memory elements
+     * 
+     * @return ElementTable& Element table of the manager
+     */
+    virtual ElementTable& get_element_table() noexcept = 0;
+
+    /**
+     * @brief Gets the table with metadata of all memory elements (const version)
+     * 
+     * @return const ElementTable& Element table of the manager
+     */
+    virtual const ElementTable& get_element_table() const noexcept = 0;
+
     /**
      * @brief Gets all errors from the error log
      * 
@@ -221,6 +398,28 @@ public:
      * @return std::vector<Error> Vector of errors for the specified program
      */
     virtual std::vector<Error> program_errors(const std::string& program_name) const = 0;
+
+    /**
+     * @brief Gets errors of a specific type
+     * 
+     * @param type Error type
+     * @return std::vector<Error> Vector of errors of the type
+     */
+    virtual std::vector<Error> type_errors(error_t type) const = 0;
+
+    /**
+     * @brief Gets the error log
+     * 
+     * @return const ErrorLog& Log with counters of kept and recorded errors
+     */
+    virtual const ErrorLog& get_error_log() const noexcept = 0;
+
+    /**
+     * @brief Gets the error log to configure rate limits
+     * 
+     * @return ErrorLog& Log of the manager
+     */
+    virtual ErrorLog& get_error_log() noexcept = 0;
     
     /**
      * @brief Finds all dangling references
@@ -235,11 +434,42 @@ public:
      * @return std::unordered_map<std::string, double> Map of program names to memory usage ratio
      */
     virtual std::unordered_map<std::string, double> statistics() const = 0;
+
+    /**
+     * @brief Gets a snapshot of memory usage and fragmentation
+     * 
+     * The counters are maintained on every operation, so the snapshot
+     * is cheap enough to read every frame.
+     * 
+     * @return MemoryStats Used and free bytes, free blocks and per-program usage
+     */
+    virtual MemoryStats get_stats() const noexcept = 0;
+
+    /**
+     * @brief Gets the free blocks of the memory buffer
+     * 
+     * @return const std::vector<Block>& Free blocks ordered by offset
+     */
+    virtual const std::vector<Block>& get_free_blocks() const = 0;
     
     /**
      * @brief Defragments memory by compacting allocated blocks
      */
     virtual void defragment_memory() = 0;
+
+    /**
+     * @brief Attaches a recorder of allocation events
+     * 
+     * @param recorder Recorder to report to, or nullptr to stop recording; must outlive the attachment
+     */
+    virtual void set_trace_recorder(TraceRecorder* recorder) noexcept = 0;
+
+    /**
+     * @brief Gets the attached recorder of allocation events
+     * 
+     * @return TraceRecorder* Attached recorder, or nullptr if none
+     */
+    virtual TraceRecorder* get_trace_recorder() const noexcept = 0;
     
     /**
      * @brief Virtual destructor for interface
@@ -249,6 +479,10 @@ public:
     /**
      * @brief Allocates a new memory element of specified type
      * 
+     * Arrays and segments are aligned to the natural alignment of their
+     * element size (the first extra argument), so typed access to their
+     * data is aligned for T. Variables are copied bytewise and unaligned.
+     * 
      * @tparam Descriptor Type of memory element descriptor to allocate
      * @tparam ExtraArgs Types of additional arguments for descriptor construction
      * @param name Name of the new memory element
@@ -259,10 +493,16 @@ public:
      */
     template <memory_element_t Descriptor, typename... ExtraArgs>
     Descriptor* allocate_element(const std::string& name, size_t size, const Program& program, ExtraArgs&&... args){
-        if(check_exist_with_allocate_error(name, program)) return nullptr;
-        if(auto offset = valid_allocate(size, program); offset.has_value()){
-            Descriptor* element = new Descriptor(name, size, *offset, args..., *this);
-            insert_element(element);
+        constexpr bool publish = Descriptor::has_kind(ElementKind::Shared) && !Descriptor::has_kind(ElementKind::Array);
+        if(check_exist_with_allocate_error(name, program, publish)) return nullptr;
+        size_t element_size = 1;
+        if constexpr (sizeof...(ExtraArgs) != 0){
+            if constexpr (std::is_integral_v<std::remove_cvref_t<std::tuple_element_t<0, std::tuple<ExtraArgs...>>>>)
+                element_size = static_cast<size_t>(std::get<0>(std::forward_as_tuple(args...)));
+        }
+        if(auto offset = valid_allocate(size, natural_alignment(element_size), program); offset.has_value()){
+            Descriptor* element = get_descriptor_pool().create<Descriptor>(name, size, *offset, args..., *this);
+            register_element(element, program);
             return element;
         }
         return nullptr; 
@@ -3,7 +3,10 @@
 
 #include <string>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <Memory/Buffer.hpp>
+#include <Memory/NameHash.hpp>
 
 namespace MemoryNameSpace{
 
@@ -12,6 +15,33 @@ namespace MemoryNameSpace{
  */
 class Program;
 
+/**
+ * @enum ElementKind
+ * @brief Concrete kind of a memory element
+ * 
+ * Stored in every element so type checks are a byte compare
+ * instead of a dynamic_cast.
+ */
+enum class ElementKind : uint8_t {
+    Variable,   ///< VariableDescriptor
+    Array,      ///< ArrayDescriptor
+    Shared,     ///< SharedSegmentDescriptor
+    Reference   ///< ReferenceDescriptor
+};
+
+/**
+ * @brief Index of an element in the manager's ElementTable
+ */
+using ElementId = uint32_t;
+
+/**
+ * @brief Identifier of a program assigned by the manager
+ */
+using ProgramId = uint32_t;
+
+inline constexpr ElementId INVALID_ELEMENT_ID = std::numeric_limits<ElementId>::max(); ///< Id of elements without table slot
+inline constexpr ProgramId INVALID_PROGRAM_ID = std::numeric_limits<ProgramId>::max(); ///< Id of an unknown program
+
 /**
  * @class IMemoryElement
  * @brief Interface for all memory elements in the memory management system
@@ -21,13 +51,45 @@ class Program;
  * It provides methods for accessing and manipulating memory content.
  */
 class IMemoryElement{
+protected:
+    ElementKind kind_;  ///< Concrete kind of the element
+    ElementId id_;      ///< Slot in the manager's ElementTable
+
+    /**
+     * @brief Constructs the interface part of an element
+     * 
+     * @param kind Concrete kind of the element
+     */
+    explicit IMemoryElement(ElementKind kind) noexcept : kind_(kind), id_(INVALID_ELEMENT_ID) {}
+
 public:
+    /**
+     * @brief Gets the concrete kind of the element
+     * 
+     * @return ElementKind Kind of the element
+     */
+    ElementKind get_kind() const noexcept { return kind_; }
+
+    /**
+     * @brief Gets the id of the element in the manager's ElementTable
+     * 
+     * @return ElementId Element id, or INVALID_ELEMENT_ID for references
+     */
+    ElementId get_id() const noexcept { return id_; }
+
     /**
      * @brief Gets the name of the memory element
      * 
      * @return const std::string& Reference to the element name
      */
     virtual const std::string& get_name() const noexcept = 0;
+
+    /**
+     * @brief Gets the precomputed hash of the element name
+     * 
+     * @return size_t Hash of the element name
+     */
+    virtual size_t get_name_hash() const noexcept = 0;
     
     /**
      * @brief Gets the total size of the memory element
@@ -102,7 +164,7 @@ public:
      * @return true if this is a reference element
      * @return false if this is not a reference element
      */
-    virtual bool is_reference() const noexcept = 0;
+    bool is_reference() const noexcept { return kind_ == ElementKind::Reference; }
     
     /**
      * @brief Virtual destructor for interface
@@ -144,6 +206,32 @@ public:
     }
 };
 
+/**
+ * @brief Checked downcast based on the element kind
+ * 
+ * @tparam T Descriptor type providing a static has_kind(ElementKind) predicate
+ * @param element Element to cast
+ * @return T* Pointer to the element as T, or nullptr if the kind doesn't match
+ */
+template<typename T>
+T* element_cast(IMemoryElement* element) noexcept {
+    if(element == nullptr || !T::has_kind(element->get_kind())) return nullptr;
+    return static_cast<T*>(element);
+}
+
+/**
+ * @brief Checked downcast based on the element kind (const version)
+ * 
+ * @tparam T Descriptor type providing a static has_kind(ElementKind) predicate
+ * @param element Element to cast
+ * @return const T* Pointer to the element as T, or nullptr if the kind doesn't match
+ */
+template<typename T>
+const T* element_cast(const IMemoryElement* element) noexcept {
+    if(element == nullptr || !T::has_kind(element->get_kind())) return nullptr;
+    return static_cast<const T*>(element);
+}
+
 }
 
 #endif
\ No newline at end of file
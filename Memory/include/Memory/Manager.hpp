@@ -1,50 +1,100 @@
 #ifndef MANAGER_HPP
 #define MANAGER_HPP
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
+#include <string_view>
 #include <cstring>
 #include <optional>
+#include <span>
+#include <vector>
 #include <Memory/IManager.hpp>
+#include <Memory/NameHash.hpp>
+#include <Memory/ElementKey.hpp>
 #include <Memory/MemoryElement.hpp>
 #include <Memory/SharedSegmentDescriptor.hpp>
+#include <Memory/Trace.hpp>
 
 namespace MemoryNameSpace{
 
 /**
  * @class Manager
- * @brief Main memory manager implementation with fixed capacity
+ * @brief Main memory manager implementation
  * 
  * The Manager class implements the IManager interface and provides
  * complete memory management functionality including allocation,
  * deallocation, error tracking, program management, and memory defragmentation.
  * 
- * @tparam capacity_ Fixed capacity of the memory buffer in bytes
+ * The buffer can also be supplied at construction, e.g. a
+ * SimulationBuffer of runtime capacity; capacity_ then only sizes the
+ * default buffer and is otherwise unused.
+ * 
+ * @tparam capacity_ Capacity of the default memory buffer in bytes
  */
 template <size_t capacity_>
 class Manager final : public IManager {
 private:
     std::unique_ptr<IBuffer> buffer_;                              ///< Memory buffer implementation
-    std::unordered_map<std::string, std::unique_ptr<IMemoryElement>> memory_elements_; ///< All memory elements
-    std::vector<Error> error_log_;                                 ///< Error log
-    std::unordered_map<std::string, std::unique_ptr<Program>> programs_; ///< Registered programs
+    std::unique_ptr<DescriptorPool> descriptor_pool_;              ///< Slab pool owning descriptor storage
+    NameArena names_;                                              ///< Interned element names
+    std::unique_ptr<ElementTable> element_table_;                  ///< Offsets, sizes and owners of all elements
+    ElementMap<PooledPtr<IMemoryElement>> retired_elements_;      ///< Elements left by deleted programs, keyed by (retired id, name)
+    NameMap<SharedSegmentDescriptor*> segments_;                   ///< Directory of shared segments by name
+    ErrorLog error_log_;                                           ///< Bounded log of error records
+    std::vector<std::unique_ptr<Program>> programs_;               ///< Registered programs indexed by id (null for free ids)
+    NameMap<ProgramId> program_ids_;                               ///< Ids of registered programs by name
+    std::vector<ProgramId> free_program_ids_;                      ///< Ids of deleted programs available for reuse
+    std::vector<size_t> keyed_elements_;                           ///< Number of entries in retired_elements_ keyed by each id
+    size_t element_count_ = 0;                                     ///< Number of live elements, including references
+    std::vector<size_t> program_usage_;                            ///< Bytes of own elements and accessible segments by program id
+    std::unordered_multimap<const IMemoryElement*, ReferenceDescriptor*> referrers_; ///< Reverse index from targets to their references
+    std::unordered_set<ReferenceDescriptor*> dungling_refs_;       ///< References whose target has been destroyed
+    TraceRecorder* trace_recorder_ = nullptr;                      ///< Recorder of allocation events, if attached
+    size_t moved_bytes_ = 0;                                       ///< Bytes moved by all defragmentations
 
 private:
+    /**
+     * @brief Invokes a callback for each registered program
+     * 
+     * @param callback Callback to invoke
+     * @param context Opaque pointer passed to the callback
+     */
+    void visit_programs(ProgramCallback callback, void* context) const override {
+        for(auto&& program : programs_)
+            if(program) callback(context, *program);
+    }
+
+    /**
+     * @brief Invokes a callback for each memory element
+     * 
+     * @param callback Callback to invoke
+     * @param context Opaque pointer passed to the callback
+     */
+    void visit_elements(ElementCallback callback, void* context) const override {
+        for(auto&& program : programs_){
+            if(!program) continue;
+            for(auto&& [name, element] : program->get_owned_elements())
+                callback(context, *element);
+        }
+        for(auto&& [key, element] : retired_elements_)
+            callback(context, *element);
+    }
+
     /**
      * @brief Validates and performs memory allocation
      * 
      * @param size Size to allocate in bytes
+     * @param alignment Required alignment of the offset
      * @param program Program requesting allocation
-     * @return std::optional<size_t> Offset of allocated block, or nullopt on failure
-     */
-    std::optional<size_t> valid_allocate(size_t size, const Program& program) override {
-        size_t offset = 0;
-        try{ offset = buffer_->allocate_block(size); }
-        catch(const std::runtime_error& e){
-            record_error(SIZE_ERROR, e.what(), program.get_name());
-            return std::nullopt;
-        }
+     * @return std::expected<size_t, BufferError> Offset of allocated block, or the failure reason (error recorded)
+     */
+    std::expected<size_t, BufferError> valid_allocate(size_t size, size_t alignment, const Program& program) override {
+        auto offset = buffer_->try_allocate_block(size, alignment);
+        if(!offset) record_error(ErrorCode::BufferOverflow, program.get_name(), {});
         return offset;
     }
 
@@ -54,20 +104,14 @@ private:
      * @param offset Offset of block to destroy
      * @param size Size of block to destroy
      * @param program Program requesting destruction
-     * @return true if destruction was successful
-     * @return false if destruction failed
+     * @return std::expected<void, BufferError> Nothing, or the failure reason (error recorded)
      */
-    bool valid_destroy(size_t offset, size_t size, const Program& program) override {
-        try{ buffer_->destroy_block(offset, size); }
-        catch(const std::out_of_range& e){
-            record_error(SIZE_ERROR, e.what(), program.get_name());
-            return false;
-        }
-        catch(const std::runtime_error& e){
-            record_error(DOUBLE_FREE, e.what(), program.get_name());
-            return false;
-        }
-        return true;
+    std::expected<void, BufferError> valid_destroy(size_t offset, size_t size, const Program& program) override {
+        auto result = buffer_->try_destroy_block(offset, size);
+        if(!result)
+            record_error(result.error() == BufferError::OutOfRange ? ErrorCode::InvalidBlock : ErrorCode::DoubleFree,
+                         program.get_name(), ErrorContext{{}, {}, {offset, size, 0}});
+        return result;
     }
 
     /**
@@ -78,10 +122,10 @@ private:
      * @return true if element exists (error recorded)
      * @return false if element doesn't exist
      */
-    bool check_exist_with_allocate_error(const std::string& name, const Program& program) override {
-        auto it = memory_elements_.find(name);
-        if(it != memory_elements_.end()){
-            record_error(MEMORY_LEAK, "Invalid write. The memory for variable '" + name + "' has already been allocated.", program.get_name());
+    bool check_exist_with_allocate_error(const std::string& name, const Program& program, bool publish) override {
+        if(program.find_element(name) != nullptr || program.find_owned_element(name) != nullptr ||
+           (publish && segments_.contains(name))){
+            record_error(ErrorCode::AlreadyAllocated, program.get_name(), {name});
             return true;
         }
         return false;
@@ -96,14 +140,76 @@ private:
      * @return false if element exists
      */
     bool check_exist_with_destroy_error(const std::string& name, const Program& program) override {
-        auto it = memory_elements_.find(name);
-        if(it == memory_elements_.end()){
-            record_error(MEMORY_LEAK, "Invalid free. The memory for variable '" + name + "' has already been free.", program.get_name());
+        if(locate(name, program) == nullptr){
+            record_error(ErrorCode::AlreadyFreed, program.get_name(), {name});
             return true;
         }
         return false;
     }
 
+    /**
+     * @brief Inserts a newly allocated element and records its owner
+     * 
+     * @param element Pointer to the allocated memory element
+     * @param program Program that allocated the element
+     */
+    void register_element(IMemoryElement* element, const Program& program) override {
+        insert_element(element, program);
+        element_table_->set_owner(element->get_id(), program.get_id());
+        program_usage_[program.get_id()] += element->get_size();
+        if(element->get_kind() == ElementKind::Shared)
+            segments_.try_emplace_hashed(element->get_name_hash(), element->get_name(), static_cast<SharedSegmentDescriptor*>(element));
+    }
+
+    /**
+     * @brief Finds an element a program may destroy
+     * 
+     * Looks among the elements the program owns first, then in the
+     * segment directory.
+     * 
+     * @param name Name of the element
+     * @param program Program making the request
+     * @return IMemoryElement* Pointer to the element, or nullptr if not found
+     */
+    IMemoryElement* locate(std::string_view name, const Program& program) const {
+        if(IMemoryElement* element = program.find_owned_element(name)) return element;
+        auto segment = segments_.find(name);
+        return segment != segments_.end() ? segment->second : nullptr;
+    }
+
+    /**
+     * @brief Gets the registered program behind a program reference
+     * 
+     * @param program Registered program
+     * @return Program& The same program, modifiable
+     */
+    Program& registered(const Program& program) const noexcept {
+        return *programs_[program.get_id()];
+    }
+
+    /**
+     * @brief Takes an element away from whoever owns it
+     * 
+     * The owner is the requesting program, the program that created the
+     * element, or, if that program was deleted, the retired elements.
+     * 
+     * @param element Element to take
+     * @param program Program making the request
+     * @return PooledPtr<IMemoryElement> The element, or null if nobody owns it
+     */
+    PooledPtr<IMemoryElement> disown(const IMemoryElement& element, const Program& program){
+        if(PooledPtr<IMemoryElement> owned = registered(program).disown_element(element)) return owned;
+        if(element.get_id() == INVALID_ELEMENT_ID) return nullptr;
+        ProgramId owner = element_table_->get_owner(element.get_id());
+        if(Program* creator = find_program(owner)) return creator->disown_element(element);
+        auto it = retired_elements_.find(ElementKey{owner, element.get_name(), element.get_name_hash()});
+        if(it == retired_elements_.end()) return nullptr;
+        PooledPtr<IMemoryElement> owned = std::move(it->second);
+        retired_elements_.erase(it);
+        unkey_element(owner);
+        return owned;
+    }
+
     /**
      * @brief Validates shared segment access with error recording
      * 
@@ -113,46 +219,144 @@ private:
      * @return false if access is invalid (error recorded)
      */
     bool is_correct_shared_with_error(const std::string& prog_name, const std::string& segment_name){
-        auto prog_it = programs_.find(prog_name);
-        if(prog_it == programs_.end()){
-            record_error(ACCESS_ERROR, "The program does not exist.", prog_name);
+        if(find_program(prog_name) == nullptr){
+            record_error(ErrorCode::ProgramNotFound, prog_name, {});
             return false;
         }
-        auto segment_it = memory_elements_.find(segment_name);
-        if(segment_it == memory_elements_.end()){
-            record_error(ACCESS_ERROR, "The variable '" + segment_name + "' does not exist.", prog_name);
-            return false;
+        if(segments_.contains(segment_name)) return true;
+        if(find_element(prog_name, segment_name) == nullptr) record_error(ErrorCode::ElementNotFound, prog_name, {segment_name});
+        else record_error(ErrorCode::NotSharedSegment, prog_name, {segment_name});
+        return false;
+    }
+
+    /**
+     * @brief Invalidates all references bound to an element that is being destroyed
+     * 
+     * Invalidated references are moved to the dangling set.
+     * 
+     * @param target Element being destroyed
+     */
+    void invalidate_references(const IMemoryElement* target){
+        auto [first, last] = referrers_.equal_range(target);
+        for(auto it = first; it != last; ++it){
+            it->second->invalidate();
+            dungling_refs_.insert(it->second);
         }
-        SharedSegmentDescriptor* segment = dynamic_cast<SharedSegmentDescriptor*>(segment_it->second.get());
-        if(!segment){
-            record_error(ACCESS_ERROR, "The variable '" + segment_name + "' is not shared segment.", prog_name);
-            return false;
+        referrers_.erase(first, last);
+    }
+
+    /**
+     * @brief Subtracts a destroyed element from the usage of the programs that saw it
+     * 
+     * A segment counts toward every program with access, other elements
+     * toward their owner.
+     * 
+     * @param element Element being destroyed
+     */
+    void release_usage(const IMemoryElement& element) noexcept {
+        if(element.get_kind() == ElementKind::Shared){
+            static_cast<const SharedSegmentDescriptor&>(element).get_programs().for_each([&](ProgramId program){
+                program_usage_[program] -= element.get_size();
+            });
+            return;
         }
-        return true;
+        ProgramId owner = element_table_->get_owner(element.get_id());
+        if(owner < program_usage_.size()) program_usage_[owner] -= element.get_size();
+    }
+
+    /**
+     * @brief Takes the smallest id freed by a deleted program, or a new one
+     * 
+     * @return ProgramId Free slot of the program registry
+     */
+    ProgramId acquire_program_id(){
+        if(free_program_ids_.empty()){
+            programs_.emplace_back();
+            keyed_elements_.push_back(0);
+            program_usage_.push_back(0);
+            return static_cast<ProgramId>(programs_.size() - 1);
+        }
+        std::pop_heap(free_program_ids_.begin(), free_program_ids_.end(), std::greater<>{});
+        ProgramId id = free_program_ids_.back();
+        free_program_ids_.pop_back();
+        return id;
+    }
+
+    /**
+     * @brief Makes the id of a deleted program available for reuse
+     * 
+     * @param id Id without a program or keyed elements
+     */
+    void release_program_id(ProgramId id){
+        free_program_ids_.push_back(id);
+        std::push_heap(free_program_ids_.begin(), free_program_ids_.end(), std::greater<>{});
+    }
+
+    /**
+     * @brief Counts a retired element keyed by a program id as removed
+     * 
+     * A retired id is released once its last leftover element is gone.
+     * 
+     * @param id Program id the element was keyed by
+     */
+    void unkey_element(ProgramId id){
+        if(--keyed_elements_[id] == 0 && programs_[id] == nullptr) release_program_id(id);
     }
 
 public:
     /**
      * @brief Constructs a new Manager object
      */
-    Manager() : IManager(), buffer_(std::unique_ptr<IBuffer>{new Buffer<capacity_>{}}) {};
+    Manager() : IManager(), buffer_(std::unique_ptr<IBuffer>{new Buffer<capacity_>{}})
+            , descriptor_pool_(std::make_unique<DescriptorPool>()), element_table_(std::make_unique<ElementTable>()) {};
 
     /**
-     * @brief Inserts a memory element into the manager
+     * @brief Constructs a manager on a given buffer
+     * 
+     * @param buffer Buffer to allocate from; must be empty
+     */
+    explicit Manager(std::unique_ptr<IBuffer> buffer) : IManager(), buffer_(std::move(buffer))
+            , descriptor_pool_(std::make_unique<DescriptorPool>()), element_table_(std::make_unique<ElementTable>()) {};
+
+    // Programs and descriptors keep a reference to their manager, so a
+    // manager can't be copied or moved.
+    Manager(const Manager&) = delete;
+    Manager& operator=(const Manager&) = delete;
+    Manager(Manager&&) = delete;
+    Manager& operator=(Manager&&) = delete;
+
+    /**
+     * @brief Destructor for Manager
+     */
+    ~Manager() override = default;
+
+    /**
+     * @brief Hands a newly created element to the program that owns it
      * 
      * @param element Pointer to the memory element to insert
+     * @param program Program that created the element
      */
-    void insert_element(IMemoryElement* element) override {
-        memory_elements_.try_emplace(element->get_name(), std::unique_ptr<IMemoryElement>(element));
+    void insert_element(IMemoryElement* element, const Program& program) override {
+        registered(program).adopt_element(PooledPtr<IMemoryElement>(element));
+        ++element_count_;
     }
 
     /**
-     * @brief Erases a memory element from the manager
+     * @brief Destroys an element owned by a program
      * 
      * @param element Pointer to the memory element to erase
+     * @param program Program that owns the element
      */
-    void erase_element(IMemoryElement* element) override {
-        memory_elements_.erase(element->get_name());
+    void erase_element(IMemoryElement* element, const Program& program) override {
+        if(element->is_reference()){
+            ReferenceDescriptor* reference = static_cast<ReferenceDescriptor*>(element);
+            if(reference->is_valid() == false)
+                dungling_refs_.erase(reference);
+            auto [first, last] = referrers_.equal_range(reference->get_target());
+            auto it = std::find_if(first, last, [reference](const auto& pair){ return pair.second == reference; });
+            if(it != last) referrers_.erase(it);
+        }
+        if(disown(*element, program)) --element_count_;
     }
 
     /**
@@ -164,19 +368,20 @@ public:
      * @return ReferenceDescriptor* Pointer to created reference, or nullptr on failure
      */
     ReferenceDescriptor* make_reference(const std::string& name, const std::string& target_name, const Program& program) override {
-        if(check_exist_with_allocate_error(name, program)) return nullptr;
-        auto it = memory_elements_.find(target_name);
-        if(it == memory_elements_.end()){
-            record_error(ACCESS_ERROR, "The variable named '" + target_name + "' does not exist.", program.get_name());
+        if(check_exist_with_allocate_error(name, program, false)) return nullptr;
+        IMemoryElement* target = program.find_element(target_name);
+        if(target == nullptr){
+            record_error(ErrorCode::ElementNotFound, program.get_name(), {target_name});
             return nullptr;
         }
-        MemoryElement* element = dynamic_cast<MemoryElement*>(it->second.get());
+        MemoryElement* element = element_cast<MemoryElement>(target);
         if(!element){
-            record_error(ACCESS_ERROR, "You can't create a link to a link.", program.get_name());
+            record_error(ErrorCode::ReferenceToReference, program.get_name(), {});
             return nullptr;
         }
-        ReferenceDescriptor* reference = new ReferenceDescriptor{element->make_reference(name)};
-        memory_elements_.try_emplace(name, std::unique_ptr<IMemoryElement>(reference));
+        ReferenceDescriptor* reference = descriptor_pool_->create<ReferenceDescriptor>(element->make_reference(name));
+        insert_element(reference, program);
+        referrers_.emplace(element, reference);
         return reference;
     }
 
@@ -189,23 +394,32 @@ public:
      * @return false if destruction failed
      */
     bool destroy_element(const std::string& name, const Program& program) override {
-        if(check_exist_with_destroy_error(name, program)) return false;
-        auto it = memory_elements_.find(name);
-        if(!valid_destroy(it->second->get_offset(), it->second->get_size(), program)) return false;
-        memory_elements_.erase(name);
+        IMemoryElement* element = locate(name, program);
+        if(element == nullptr){
+            record_error(ErrorCode::AlreadyFreed, program.get_name(), {name});
+            return false;
+        }
+        ElementId id = element->get_id();
+        if(id != INVALID_ELEMENT_ID && element_table_->is_pinned(id)){
+            record_error(ErrorCode::ElementPinned, program.get_name(), {name});
+            return false;
+        }
+        if(!valid_destroy(element->get_offset(), element->get_size(), program)) return false;
+        invalidate_references(element);
+        release_usage(*element);
+        if(element->get_kind() == ElementKind::Shared) segments_.erase(name);
+        if(disown(*element, program)) --element_count_;
         return true;
     }
 
     /**
-     * @brief Gets a memory element by name
+     * @brief Gets a shared segment by name
      * 
      * @param target_name Name of element to retrieve
      * @return IMemoryElement* Pointer to memory element, or nullptr if not found
      */
-    IMemoryElement* get_element(const std::string& target_name) const override {
-        auto it = memory_elements_.find(target_name);
-        if(it == memory_elements_.end()) return nullptr;
-        return it->second.get();
+    IMemoryElement* get_element(std::string_view target_name) const override {
+        return find_element(target_name);
     }
 
     /**
@@ -214,9 +428,23 @@ public:
      * @param type Error type identifier
      * @param description Error description
      * @param program Name of program where error occurred
+     * @throws std::out_of_range If type isn't an error_t value
      */
     void record_error(size_t type, const std::string& description, const std::string& program) override {
-        error_log_.push_back(Error{type, description, program});
+        if(!is_error_type(type))
+            throw std::out_of_range("Invalid error type " + std::to_string(type) + ".");
+        error_log_.record_text(static_cast<error_t>(type), description, program);
+    }
+
+    /**
+     * @brief Records an error with a message template
+     * 
+     * @param code Message template, which also fixes the error type
+     * @param program Name of program where error occurred
+     * @param context Names and numbers substituted into the template
+     */
+    void record_error(ErrorCode code, std::string_view program, const ErrorContext& context) override {
+        error_log_.record(code, program, context);
     }
 
     /**
@@ -228,24 +456,43 @@ public:
      * @return Program* Pointer to created program, or nullptr on failure
      */
     Program* add_program(const std::string& name, const std::string& file_path, size_t memory_limit) override {
-        auto it = programs_.find(name);
-        if(it != programs_.end()){
-            record_error(ACCESS_ERROR, "The program has already been created.", it->second->get_name());
+        if(Program* existing = find_program(name)){
+            record_error(ErrorCode::ProgramExists, existing->get_name(), {});
             return nullptr;
         }
-        auto program = std::make_unique<Program>(name, file_path, memory_limit, *this);
-        Program* program_ptr = program.get();
-        programs_.insert({name, std::move(program)});
-        return program_ptr;
+        ProgramId id = acquire_program_id();
+        programs_[id] = std::make_unique<Program>(name, file_path, memory_limit, id, *this);
+        Program* program = programs_[id].get();
+        program_ids_.try_emplace_hashed(program->get_name_hash(), program->get_name(), id);
+        return program;
     }
 
     /**
      * @brief Deletes a program from the manager
      * 
+     * Elements the program leaked move to the retired elements, keyed by
+     * its id. The id is reused by a later program unless such elements
+     * remain; it is retired until the last of them is destroyed, so a new
+     * program never inherits another's leftovers.
+     * 
      * @param name Name of program to delete
      */
     void delete_program(const std::string& name) override {
-        programs_.erase(name);
+        auto it = program_ids_.find(name);
+        if(it == program_ids_.end()) return;
+        ProgramId id = it->second;
+        Program& program = *programs_[id];
+        program.retire();
+        NameMap<PooledPtr<IMemoryElement>> leftovers = program.disown_elements();
+        retired_elements_.reserve(retired_elements_.size() + leftovers.size());
+        for(auto&& [element_name, element] : leftovers){
+            retired_elements_.try_emplace(ElementKey{id, element_name, element->get_name_hash()}, std::move(element));
+            ++keyed_elements_[id];
+        }
+        program_ids_.erase(it);
+        programs_[id].reset();
+        program_usage_[id] = 0;
+        if(keyed_elements_[id] == 0) release_program_id(id);
     }
 
     /**
@@ -258,13 +505,18 @@ public:
      */
     bool get_access_to_shared(const std::string& prog_name, const std::string& segment_name) override {
         if(is_correct_shared_with_error(prog_name, segment_name) == false) return false;
-        Program* prog = programs_.find(prog_name)->second.get();
-        SharedSegmentDescriptor* segment = dynamic_cast<SharedSegmentDescriptor*>(memory_elements_.find(segment_name)->second.get());
+        Program* prog = find_program(prog_name);
+        SharedSegmentDescriptor* segment = segments_.find(segment_name)->second;
+        if(IMemoryElement* visible = prog->find_element(segment_name); visible != nullptr && visible != segment){
+            record_error(ErrorCode::AlreadyAllocated, prog_name, {segment_name});
+            return false;
+        }
         if(prog->possible_for_expansion(segment->get_size()) == false){
-            record_error(SIZE_ERROR, "The memory limit in the '" + segment->get_name() + "' program has been exceeded.", prog_name);
+            record_error(ErrorCode::MemoryLimitExceeded, prog_name, {segment->get_name()});
             return false;
         }
         prog->insert_element(segment);
+        if(!segment->check_access(prog->get_id())) program_usage_[prog->get_id()] += segment->get_size();
         segment->insert_program(prog);
         return true;
     }
@@ -279,13 +531,14 @@ public:
      */
     bool revoke_access_to_shared(const std::string& prog_name, const std::string& segment_name) override {
         if(is_correct_shared_with_error(prog_name, segment_name) == false) return false;
-        Program* prog = programs_.find(prog_name)->second.get();
-        SharedSegmentDescriptor* segment = dynamic_cast<SharedSegmentDescriptor*>(memory_elements_.find(segment_name)->second.get());
+        Program* prog = find_program(prog_name);
+        SharedSegmentDescriptor* segment = segments_.find(segment_name)->second;
         if(segment->is_last()){
-            record_error(MEMORY_LEAK, "This is the last program that owns the segment '" + segment->get_name() + "'.", prog_name);
+            record_error(ErrorCode::LastSegmentOwner, prog_name, {segment->get_name()});
             return false;
         }
         prog->erase_element(segment);
+        if(segment->check_access(prog->get_id())) program_usage_[prog->get_id()] -= segment->get_size();
         segment->erase_program(prog);
         return true;
     }
@@ -297,11 +550,77 @@ public:
      */
     std::unordered_map<std::string, Program*> get_programs() const override {
         std::unordered_map<std::string, Program*> programs;
-        for(auto&& [name, ptr] : programs_)
-            programs.insert({name, ptr.get()});
+        for(auto&& program : programs_)
+            if(program) programs.emplace(program->get_name(), program.get());
         return programs;
     }
 
+    /**
+     * @brief Finds a registered program without copying the program table
+     * 
+     * @param name Name of the program
+     * @return Program* Pointer to the program, or nullptr if not found
+     */
+    Program* find_program(std::string_view name) const override {
+        auto it = program_ids_.find(name);
+        if(it == program_ids_.end()) return nullptr;
+        return programs_[it->second].get();
+    }
+
+    /**
+     * @brief Finds a registered program by id
+     * 
+     * @param id Id of the program
+     * @return Program* Pointer to the program, or nullptr if the id is free
+     */
+    Program* find_program(ProgramId id) const noexcept override {
+        return id < programs_.size() ? programs_[id].get() : nullptr;
+    }
+
+    /**
+     * @brief Finds a shared segment by name
+     * 
+     * Only segments have manager-wide names; elements private to a
+     * program are found with find_element(program, name).
+     * 
+     * @param name Name of the segment
+     * @return IMemoryElement* Pointer to the segment, or nullptr if not found
+     */
+    IMemoryElement* find_element(std::string_view name) const override {
+        auto segment = segments_.find(name);
+        return segment != segments_.end() ? segment->second : nullptr;
+    }
+
+    /**
+     * @brief Finds a memory element in the namespace of a program
+     * 
+     * @param program Name of the program
+     * @param name Name of the element
+     * @return IMemoryElement* Pointer to the element, or nullptr if not found
+     */
+    IMemoryElement* find_element(std::string_view program, std::string_view name) const override {
+        Program* owner = find_program(program);
+        return owner != nullptr ? owner->find_element(name) : nullptr;
+    }
+
+    /**
+     * @brief Gets the number of registered programs
+     * 
+     * @return size_t Number of programs
+     */
+    size_t program_count() const noexcept override {
+        return program_ids_.size();
+    }
+
+    /**
+     * @brief Gets the number of memory elements
+     * 
+     * @return size_t Number of elements, including references
+     */
+    size_t element_count() const noexcept override {
+        return element_count_;
+    }
+
     /**
      * @brief Gets raw data buffer pointer
      * 
@@ -323,10 +642,65 @@ public:
     /**
      * @brief Gets the capacity of the memory buffer
      * 
-     * @return constexpr size_t Buffer capacity in bytes
+     * @return size_t Buffer capacity in bytes
+     */
+    size_t get_capacity() const noexcept override {
+        return buffer_->get_capacity();
+    }
+
+    /**
+     * @brief Gets the stored copy of a name, interning it if needed
+     * 
+     * @param name Name to intern
+     * @return const InternedName& Interned name with its hash
+     */
+    const InternedName& intern_name(std::string_view name) override {
+        return names_.intern(name);
+    }
+
+    /**
+     * @brief Gives back a name taken with intern_name
+     * 
+     * @param name Interned name no longer held by the caller
+     */
+    void release_name(const InternedName& name) noexcept override {
+        names_.release(name);
+    }
+
+    /**
+     * @brief Gets the number of distinct element names in use
+     * 
+     * @return size_t Number of interned names
+     */
+    size_t get_name_count() const noexcept {
+        return names_.size();
+    }
+
+    /**
+     * @brief Gets the pool used to allocate descriptors
+     * 
+     * @return DescriptorPool& Descriptor pool of the manager
+     */
+    DescriptorPool& get_descriptor_pool() noexcept override {
+        return *descriptor_pool_;
+    }
+
+    /**
+     * @brief Gets the table with metadata of all memory elements
+     * 
+     * @return ElementTable& Element table of the manager
+     */
+    ElementTable& get_element_table() noexcept override {
+        return *element_table_;
+    }
+
+    /**
+     * @brief Gets the table with metadata of all memory elements (const version)
+     * 
+     * @return const ElementTable& Element table of the manager
      */
-    constexpr size_t get_capacity() const noexcept override {
-        return capacity_;
+    const ElementTable& get_element_table() const noexcept override {
+        return *element_table_;
     }
 
     /**
@@ -335,7 +709,7 @@ public:
      * @return std::vector<Error> Vector of all recorded errors
      */
     std::vector<Error> all_errors() const override {
-        return error_log_;
+        return error_log_.all();
     }
 
     /**
@@ -345,27 +719,47 @@ public:
      * @return std::vector<Error> Vector of errors for the specified program
      */
     std::vector<Error> program_errors(const std::string& program_name) const override {
-        std::vector<Error> errors;
-        for(auto&& error : error_log_){
-            if(error.get_program() == program_name)
-                errors.push_back(error);
-        }
-        return errors;
+        return error_log_.by_program(program_name);
+    }
+
+    /**
+     * @brief Gets errors of a specific type
+     * 
+     * @param type Error type
+     * @return std::vector<Error> Vector of errors of the type
+     */
+    std::vector<Error> type_errors(error_t type) const override {
+        return error_log_.by_type(type);
+    }
+
+    /**
+     * @brief Gets the error log
+     * 
+     * @return const ErrorLog& Log with counters of kept and recorded errors
+     */
+    const ErrorLog& get_error_log() const noexcept override {
+        return error_log_;
+    }
+
+    /**
+     * @brief Gets the error log to configure rate limits
+     * 
+     * @return ErrorLog& Log of the manager
+     */
+    ErrorLog& get_error_log() noexcept override {
+        return error_log_;
     }
 
     /**
      * @brief Finds all dangling references
      * 
+     * The dangling set is maintained on destruction, so the cost is
+     * proportional to the number of dangling references.
+     * 
      * @return std::vector<ReferenceDescriptor*> Vector of dangling reference pointers
      */
     std::vector<ReferenceDescriptor*> dungling_reference() const override {
-        std::vector<ReferenceDescriptor*> dungling_refs;
-        for(auto&& [name, ptr] : memory_elements_){
-            ReferenceDescriptor* ref = dynamic_cast<ReferenceDescriptor*>(ptr.get());
-            if(ref && (ref->is_valid() == false))
-                dungling_refs.push_back(ref);
-        }
-        return dungling_refs;
+        return std::vector<ReferenceDescriptor*>(dungling_refs_.begin(), dungling_refs_.end());
     }
 
     /**
@@ -375,12 +769,39 @@ public:
      */
     std::unordered_map<std::string, double> statistics() const override {
         std::unordered_map<std::string, double> table;
-        for(auto&& [name, ptr] : programs_){
-            table.insert({name, static_cast<double>(ptr->get_used_memory()) / static_cast<double>(capacity_)});
+        table.reserve(program_ids_.size());
+        for(auto&& program : programs_){
+            if(program) table.emplace(program->get_name(), static_cast<double>(program_usage_[program->get_id()]) / static_cast<double>(get_capacity()));
         }
         return table;
     }
 
+    /**
+     * @brief Gets a snapshot of memory usage and fragmentation
+     * 
+     * @return MemoryStats Counters maintained by the buffer and the manager
+     */
+    MemoryStats get_stats() const noexcept override {
+        MemoryStats stats;
+        stats.capacity = buffer_->get_capacity();
+        stats.free = buffer_->get_free_memory();
+        stats.used = stats.capacity - stats.free;
+        stats.largest_free_block = buffer_->get_largest_free_block();
+        stats.free_blocks = buffer_->get_free_block_count();
+        stats.moved_bytes = moved_bytes_;
+        stats.program_usage = program_usage_;
+        return stats;
+    }
+
+    /**
+     * @brief Gets the free blocks of the memory buffer
+     * 
+     * @return const std::vector<Block>& Free blocks ordered by offset
+     */
+    const std::vector<Block>& get_free_blocks() const override {
+        return buffer_->get_blocks();
+    }
+
     /**
      * @brief Gets all memory elements managed by this manager
      * 
@@ -388,9 +809,8 @@ public:
      */
     std::unordered_map<std::string, IMemoryElement*> get_memory_elements() const override {
         std::unordered_map<std::string, IMemoryElement*> result;
-        result.reserve(memory_elements_.size());
-        for (auto& [name, ptr] : memory_elements_)
-            result.emplace(name, ptr.get());
+        result.reserve(element_count_);
+        for_each_element([&result](IMemoryElement& element){ result.emplace(element.get_name(), &element); });
         return result;
     }
 
@@ -399,32 +819,58 @@ public:
      * 
      * This method moves all allocated memory blocks to the beginning of the buffer,
      * eliminating fragmentation and creating a single large free block at the end.
+     * Blocks keep their alignment, and the padding between them is returned
+     * to the free list. Nothing is moved while a view pins any element; an
+     * error is recorded instead. A buffer without storage only has its
+     * offsets updated.
      */
     void defragment_memory() override {
-        std::vector<IMemoryElement*> elems;
-        for(auto& [name, ptr] : memory_elements_)
-            elems.push_back(ptr.get());
-
-        std::sort(elems.begin(), elems.end(), [](IMemoryElement* a, IMemoryElement* b){
-                return a->get_offset() < b->get_offset();
-        });
-
+        ElementTable& table = *element_table_;
+        if(table.get_pin_count() != 0){
+            record_error(ErrorCode::DefragmentationPinned, "", ErrorContext{{}, {}, {table.get_pin_count(), 0, 0}});
+            return;
+        }
+        std::byte* data = buffer_->get_data();
+        std::vector<Block> padding;
         size_t new_offset = 0;
-        for (IMemoryElement* elem : elems) {
-            size_t old_offset = elem->get_offset();
-            size_t size = elem->get_size();
+        for (ElementId id : table.ids_by_offset()) {
+            size_t old_offset = table.get_offset(id);
+            size_t size = table.get_size(id);
+            // Offsets were aligned before, so the aligned target never passes the source.
+            if (size_t gap = alignment_padding(new_offset, natural_alignment(table.get_kind(id) == ElementKind::Variable ? 1 : table.get_elem_size(id))); gap != 0) {
+                padding.push_back(Block{new_offset, gap});
+                new_offset += gap;
+            }
 
             if (old_offset != new_offset) {
-                std::memmove(buffer_->get_data() + new_offset, buffer_->get_data() + old_offset, size);
-                elem->set_offset(new_offset);
+                if (data) std::memmove(data + new_offset, data + old_offset, size);
+                table.set_offset(id, new_offset);
+                moved_bytes_ += size;
             }
             new_offset += size;
         }
 
-        auto& blocks = buffer_->get_blocks();
-        blocks.clear();
-        if (new_offset < capacity_)
-            blocks.push_back(Block{new_offset, capacity_ - new_offset});
+        buffer_->compact(new_offset);
+        for (const Block& gap : padding) buffer_->destroy_block(gap.offset, gap.size);
+        if(trace_recorder_) trace_recorder_->record_defragment();
+    }
+
+    /**
+     * @brief Attaches a recorder of allocation events
+     * 
+     * @param recorder Recorder to report to, or nullptr to stop recording
+     */
+    void set_trace_recorder(TraceRecorder* recorder) noexcept override {
+        trace_recorder_ = recorder;
+    }
+
+    /**
+     * @brief Gets the attached recorder of allocation events
+     * 
+     * @return TraceRecorder* Attached recorder, or nullptr if none
+     */
+    TraceRecorder* get_trace_recorder() const noexcept override {
+        return trace_recorder_;
     }
 };
 
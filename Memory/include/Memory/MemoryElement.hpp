@@ -2,6 +2,7 @@
 #define MEMORYELEMENT_HPP
 
 #include <string>
+#include <string_view>
 #include <cstddef>
 #include <Memory/IMemoryElement.hpp>
 #include <Memory/ReferenceDescriptor.hpp>
@@ -16,25 +17,61 @@ namespace MemoryNameSpace{
  * MemoryElement provides the basic implementation for memory elements
  * including name, size, offset management, and raw value operations.
  * It serves as a base class for specific memory element types.
+ * 
+ * Accessors that read or write element data throw std::runtime_error
+ * when the manager's buffer has no storage, as with a SimulationBuffer.
  */
 class MemoryElement : public IMemoryElement{
 protected:
-    std::string name_;     ///< Name of the memory element
-    size_t size_;          ///< Total size in bytes
-    size_t offset_;        ///< Offset in the memory buffer
-    IManager& manager_;    ///< Reference to the memory manager
+    const InternedName* name_; ///< Interned name of the memory element
+    ElementTable& table_;      ///< Table holding offset, size and owner of the element
+    IManager& manager_;        ///< Reference to the memory manager
+
+    /**
+     * @brief Gets the name of the program owning the element
+     * 
+     * Errors found by the element itself are recorded under this name.
+     * 
+     * @return std::string_view Owner name, or empty if the element has no owner
+     */
+    std::string_view get_owner_name() const noexcept;
+
+    /**
+     * @brief Gets the address of the element's first byte in the buffer
+     * 
+     * @return std::byte* Pointer into the manager's buffer
+     * @throws std::runtime_error If the buffer has no storage (e.g. a SimulationBuffer)
+     */
+    std::byte* raw_data() const;
 
 public:
     /**
      * @brief Constructs a new MemoryElement object
      * 
+     * Registers the element in the manager's ElementTable.
+     * 
+     * @param kind Concrete kind of the element
      * @param name Name of the memory element
      * @param size Total size in bytes
      * @param offset Offset in the memory buffer
+     * @param elem_size Size of individual elements in bytes
      * @param manager Reference to the memory manager
      */
-    MemoryElement(const std::string& name, size_t size, size_t offset, IManager& manager)
-            : name_(name), size_(size), offset_(offset), manager_(manager) {}
+    MemoryElement(ElementKind kind, const std::string& name, size_t size, size_t offset, size_t elem_size, IManager& manager)
+            : IMemoryElement(kind), name_(&manager.intern_name(name)), table_(manager.get_element_table()), manager_(manager) {
+        id_ = table_.insert(this, kind, offset, size, elem_size);
+    }
+
+    MemoryElement(const MemoryElement&) = delete;
+    MemoryElement& operator=(const MemoryElement&) = delete;
+
+    /**
+     * @brief Checks whether a kind denotes a MemoryElement
+     * 
+     * @param kind Kind to check
+     * @return true for all kinds except references
+     */
+    static constexpr bool has_kind(ElementKind kind) noexcept { return kind != ElementKind::Reference; }
     
     /**
      * @brief Gets the name of the memory element
@@ -42,6 +79,13 @@ public:
      * @return const std::string& Reference to the element name
      */
     const std::string& get_name() const noexcept override;
+
+    /**
+     * @brief Gets the precomputed hash of the element name
+     * 
+     * @return size_t Hash of the element name
+     */
+    size_t get_name_hash() const noexcept override;
     
     /**
      * @brief Gets the total size of the memory element
@@ -74,20 +118,28 @@ public:
     /**
      * @brief Gets raw bytes from the memory element
      * 
+     * Only bytes [begin, end) are copied when end is not 0.
+     * 
      * @param value Buffer to store retrieved bytes
      * @param begin Starting byte offset within element
      * @param end Ending byte offset within element (0 for all)
+     * @throws std::runtime_error If the byte range is outside the element
+     *         or the buffer has no storage
      */
-    void get_raw_value(std::byte* value, size_t, size_t) const override;
+    void get_raw_value(std::byte* value, size_t begin, size_t end) const override;
     
     /**
      * @brief Sets raw bytes in the memory element
      * 
+     * Only bytes [begin, end) are written when end is not 0.
+     * 
      * @param value Buffer containing bytes to set
      * @param begin Starting byte offset within element
      * @param end Ending byte offset within element (0 for all)
+     * @throws std::runtime_error If the byte range is outside the element
+     *         or the buffer has no storage
      */
-    void set_raw_value(const std::byte* value, size_t , size_t) override;
+    void set_raw_value(const std::byte* value, size_t begin, size_t end) override;
     
     /**
      * @brief Checks if the element can be destroyed by the specified program
@@ -107,13 +159,6 @@ public:
      */
     bool destroy(Program& prog) override;
     
-    /**
-     * @brief Checks if this is a reference element
-     * 
-     * @return false (MemoryElement is not a reference)
-     */
-    bool is_reference() const noexcept override;
-    
     /**
      * @brief Creates a reference to this memory element
      * 
@@ -124,6 +169,8 @@ public:
     
     /**
      * @brief Virtual destructor for base class
+     * 
+     * Releases the element's slot in the ElementTable.
      */
     virtual ~MemoryElement() = 0;
 };
@@ -0,0 +1,49 @@
+#ifndef MEMORYSTATS_HPP
+#define MEMORYSTATS_HPP
+
+#include <cstddef>
+#include <span>
+#include <Memory/IMemoryElement.hpp>
+
+namespace MemoryNameSpace{
+
+/**
+ * @struct MemoryStats
+ * @brief Snapshot of memory usage maintained incrementally by the manager
+ *
+ * Every field is updated as blocks are allocated and freed and as
+ * programs gain or lose access to segments, so reading a snapshot costs
+ * nothing proportional to the number of elements or free blocks.
+ */
+struct MemoryStats{
+    size_t capacity = 0;                 ///< Size of the buffer in bytes
+    size_t used = 0;                     ///< Bytes in allocated blocks
+    size_t free = 0;                     ///< Bytes in free blocks
+    size_t largest_free_block = 0;       ///< Size of the largest free block
+    size_t free_blocks = 0;              ///< Number of free blocks
+    size_t moved_bytes = 0;              ///< Bytes moved by all defragmentations so far
+    std::span<const size_t> program_usage; ///< Bytes visible to each program, indexed by ProgramId (valid until the next operation)
+
+    /**
+     * @brief Gets the external fragmentation ratio
+     *
+     * @return double 1 - largest_free_block / free, or 0 if nothing is free
+     */
+    double fragmentation() const noexcept {
+        return free == 0 ? 0.0 : 1.0 - static_cast<double>(largest_free_block) / static_cast<double>(free);
+    }
+
+    /**
+     * @brief Gets the bytes used by a program
+     *
+     * @param program Id of the program
+     * @return size_t Own elements plus accessible segments, or 0 for an unknown id
+     */
+    size_t usage(ProgramId program) const noexcept {
+        return program < program_usage.size() ? program_usage[program] : 0;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef NAMEARENA_HPP
+#define NAMEARENA_HPP
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <vector>
+#include <Memory/NameHash.hpp>
+#include <Memory/FlatTable.hpp>
+
+namespace MemoryNameSpace{
+
+/**
+ * @struct InternedName
+ * @brief Name stored once in a NameArena together with its hash
+ */
+struct InternedName{
+    std::string name;      ///< Name text
+    size_t hash = 0;       ///< Hash of the name
+    size_t references = 0; ///< Number of intern calls not yet released
+};
+
+/**
+ * @class NameArena
+ * @brief Interning storage for element names
+ *
+ * Each distinct name is stored once and never moves, so descriptors
+ * and name-keyed tables can refer to it by pointer or std::string_view
+ * instead of owning a copy. Names are reference counted: every intern
+ * is paired with a release, and a name nobody holds is dropped and its
+ * slot reused with its capacity, so the arena is bounded by the names in
+ * use and a name that fits a released slot is stored without allocating.
+ */
+class NameArena final{
+private:
+    std::deque<InternedName> names_;                                             ///< Stable storage for names
+    std::vector<InternedName*> free_;                                            ///< Released slots available for reuse
+    FlatTable<std::string_view, InternedName*, NameHash, NameEqual> index_;      ///< Lookup from text to stored name
+
+public:
+    /**
+     * @brief Gets the stored copy of a name, adding it if needed
+     *
+     * Each call takes a reference that must be given back with release.
+     *
+     * @param name Name to intern
+     * @return const InternedName& Stored name with its hash
+     */
+    const InternedName& intern(std::string_view name);
+
+    /**
+     * @brief Gives back a reference taken by intern
+     *
+     * The name is dropped once its last reference is released.
+     *
+     * @param name Name returned by intern
+     */
+    void release(const InternedName& name) noexcept;
+
+    /**
+     * @brief Finds the stored copy of a name without adding it
+     *
+     * @param name Name to look up
+     * @return const InternedName* Stored name, or nullptr if it isn't held
+     */
+    const InternedName* find(std::string_view name) const;
+
+    /**
+     * @brief Gets the number of distinct names
+     *
+     * @return size_t Number of names currently held
+     */
+    size_t size() const noexcept;
+};
+
+}
+
+#endif
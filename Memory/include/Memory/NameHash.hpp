@@ -0,0 +1,93 @@
+#ifndef NAMEHASH_HPP
+#define NAMEHASH_HPP
+
+#include <string>
+#include <string_view>
+#include <functional>
+#include <Memory/FlatTable.hpp>
+
+namespace MemoryNameSpace{
+
+/**
+ * @brief Computes the hash of an element or program name
+ *
+ * @param name Name to hash
+ * @return size_t Hash value
+ */
+inline size_t hash_name(std::string_view name) noexcept {
+    return std::hash<std::string_view>{}(name);
+}
+
+/**
+ * @struct HashedName
+ * @brief Name view paired with its precomputed hash
+ *
+ * Used as a lookup key so tables don't hash the name again.
+ */
+struct HashedName{
+    std::string_view name; ///< Name of the element or program
+    size_t hash = 0;       ///< Precomputed hash of the name
+};
+
+/**
+ * @struct NameHash
+ * @brief Transparent hasher for name-keyed tables
+ *
+ * Accepts std::string, std::string_view and const char* without
+ * building temporary strings, and reuses the hash stored in HashedName.
+ */
+struct NameHash{
+    using is_transparent = void;
+
+    /**
+     * @brief Hashes a name view
+     *
+     * @param name Name to hash
+     * @return size_t Hash value
+     */
+    size_t operator()(std::string_view name) const noexcept { return hash_name(name); }
+
+    /**
+     * @brief Returns the precomputed hash of a name
+     *
+     * @param name Name with precomputed hash
+     * @return size_t Stored hash value
+     */
+    size_t operator()(const HashedName& name) const noexcept { return name.hash; }
+};
+
+/**
+ * @struct NameEqual
+ * @brief Transparent equality for name-keyed tables
+ */
+struct NameEqual{
+    using is_transparent = void;
+
+    /**
+     * @brief Compares two names of any supported key type
+     *
+     * @return true if names are equal
+     * @return false otherwise
+     */
+    template<typename L, typename R>
+    bool operator()(const L& lhs, const R& rhs) const noexcept { return view(lhs) == view(rhs); }
+
+private:
+    static std::string_view view(std::string_view name) noexcept { return name; }
+    static std::string_view view(const HashedName& name) noexcept { return name.name; }
+};
+
+/**
+ * @brief Name-keyed hash table with heterogeneous lookup
+ *
+ * Keys are views of names owned elsewhere (interned element names,
+ * program names), so an entry must be erased before its name dies.
+ *
+ * @tparam T Mapped type
+ */
+template<typename T>
+using NameMap = FlatTable<std::string_view, T, NameHash, NameEqual>;
+
+}
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef PINNEDSPAN_HPP
+#define PINNEDSPAN_HPP
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <Memory/ElementTable.hpp>
+
+namespace MemoryNameSpace{
+
+/**
+ * @class PinnedSpan
+ * @brief Typed view over the live bytes of a memory element
+ *
+ * The view pins its element in the ElementTable for its whole lifetime:
+ * defragmentation is refused and the element can't be destroyed until
+ * every view is released. The span can be passed to STL algorithms
+ * and reductions without copying data out of the buffer.
+ *
+ * The view must not outlive the manager that owns the element.
+ *
+ * @tparam T Element type (const-qualified for read-only views)
+ */
+template<typename T>
+class PinnedSpan final{
+private:
+    ElementTable* table_ = nullptr;       ///< Table holding the pin (nullptr once released)
+    ElementId id_ = INVALID_ELEMENT_ID;   ///< Pinned element
+    std::span<T> span_;                   ///< Viewed data
+
+public:
+    using element_type = T;                                     ///< Type of viewed elements
+    using iterator = typename std::span<T>::iterator;           ///< Iterator over viewed elements
+
+    /**
+     * @brief Constructs an empty view
+     */
+    PinnedSpan() noexcept = default;
+
+    /**
+     * @brief Constructs a view and pins its element
+     *
+     * @param table Table of the element's manager
+     * @param id Id of the viewed element
+     * @param span Viewed data
+     */
+    PinnedSpan(ElementTable& table, ElementId id, std::span<T> span) noexcept
+            : table_(&table), id_(id), span_(span) {
+        table_->pin(id_);
+    }
+
+    PinnedSpan(const PinnedSpan&) = delete;
+    PinnedSpan& operator=(const PinnedSpan&) = delete;
+
+    /**
+     * @brief Moves the pin from another view
+     */
+    PinnedSpan(PinnedSpan&& other) noexcept
+            : table_(std::exchange(other.table_, nullptr)), id_(other.id_), span_(std::exchange(other.span_, {})) {}
+
+    /**
+     * @brief Releases the current pin and takes over the pin of another view
+     */
+    PinnedSpan& operator=(PinnedSpan&& other) noexcept {
+        if(this != &other){
+            release();
+            table_ = std::exchange(other.table_, nullptr);
+            id_ = other.id_;
+            span_ = std::exchange(other.span_, {});
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Releases the pin
+     */
+    ~PinnedSpan() { release(); }
+
+    /**
+     * @brief Releases the pin early and empties the view
+     */
+    void release() noexcept {
+        if(table_ != nullptr) table_->unpin(id_);
+        table_ = nullptr;
+        span_ = {};
+    }
+
+    /**
+     * @brief Gets the underlying span
+     *
+     * @return std::span<T> Viewed data, valid while the view is alive
+     */
+    std::span<T> get() const noexcept { return span_; }
+
+    /**
+     * @brief Gets a pointer to the first viewed element
+     */
+    T* data() const noexcept { return span_.data(); }
+
+    /**
+     * @brief Gets the number of viewed elements
+     */
+    size_t size() const noexcept { return span_.size(); }
+
+    /**
+     * @brief Checks whether the view is empty
+     */
+    bool empty() const noexcept { return span_.empty(); }
+
+    /**
+     * @brief Gets an iterator to the first viewed element
+     */
+    iterator begin() const noexcept { return span_.begin(); }
+
+    /**
+     * @brief Gets an iterator past the last viewed element
+     */
+    iterator end() const noexcept { return span_.end(); }
+
+    /**
+     * @brief Accesses a viewed element without bounds checking
+     *
+     * @param index Index of the element
+     * @return T& Reference to the element
+     */
+    T& operator[](size_t index) const noexcept { return span_[index]; }
+};
+
+}
+
+#endif
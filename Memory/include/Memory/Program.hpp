@@ -4,7 +4,9 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include <string_view>
 #include <Memory/IManager.hpp>
+#include <Memory/NameHash.hpp>
 
 namespace MemoryNameSpace{
 
@@ -13,6 +15,23 @@ namespace MemoryNameSpace{
  */
 class IMemoryElement;  // forward
 
+/**
+ * @enum UsedMemoryStrategy
+ * @brief Ways to sum the memory used by a program
+ */
+enum class UsedMemoryStrategy : uint8_t {
+    Auto,         ///< Serial below the parallel threshold, Tbb from it on
+    Serial,       ///< std::transform_reduce on the calling thread
+    ParallelStl,  ///< std::transform_reduce with std::execution::par
+    Threads,      ///< One std::thread per hardware thread
+    Tbb           ///< tbb::parallel_reduce
+};
+
+/**
+ * @brief Default number of elements from which UsedMemoryStrategy::Auto sums in parallel
+ */
+inline constexpr size_t USED_MEMORY_PARALLEL_THRESHOLD = 1 << 15;
+
 /**
  * @class Program
  * @brief Represents a program with memory management capabilities
@@ -27,11 +46,21 @@ class IMemoryElement;  // forward
 class Program final{
 private:
     std::string name_;                          ///< Name of the program
+    size_t name_hash_;                          ///< Precomputed hash of the name
+    ProgramId id_;                              ///< Identifier assigned by the manager
     std::string file_path_;                     ///< Path to the program file
     size_t memory_limit_;                       ///< Maximum memory limit for this program
-    std::unordered_map<std::string, IMemoryElement*> memory_elements_; ///< Map of memory elements owned by this program
+    NameMap<IMemoryElement*> memory_elements_; ///< Namespace of the program: own elements, references and accessible segments
+    NameMap<PooledPtr<IMemoryElement>> owned_elements_; ///< Elements allocated and references made by the program
     IManager& manager_;                         ///< Reference to the memory manager
 
+    /**
+     * @brief Reports an allocation to the manager's trace recorder, if one is attached
+     * 
+     * @param element Allocated element
+     */
+    void trace_allocation(const IMemoryElement& element) const;
+
 public:
     /**
      * @brief Constructs a new Program object
@@ -39,10 +68,11 @@ public:
      * @param name Name of the program
      * @param file_path Path to the program file
      * @param memory_limit Maximum memory limit in bytes
+     * @param id Identifier assigned by the manager
      * @param manager Reference to the memory manager
      */
-    Program(std::string name, std::string file_path, size_t memory_limit, IManager& manager)
-            : name_(name), file_path_(file_path), memory_limit_(memory_limit), memory_elements_(), manager_(manager) {}
+    Program(std::string name, std::string file_path, size_t memory_limit, ProgramId id, IManager& manager)
+            : name_(name), name_hash_(hash_name(name)), id_(id), file_path_(file_path), memory_limit_(memory_limit), memory_elements_(), owned_elements_(), manager_(manager) {}
     
     /**
      * @brief Gets the name of the program
@@ -50,6 +80,20 @@ public:
      * @return const std::string& Reference to the program name
      */
     const std::string& get_name() const;
+
+    /**
+     * @brief Gets the precomputed hash of the program name
+     * 
+     * @return size_t Hash of the program name
+     */
+    size_t get_name_hash() const noexcept;
+
+    /**
+     * @brief Gets the identifier of the program
+     * 
+     * @return ProgramId Identifier assigned by the manager
+     */
+    ProgramId get_id() const noexcept;
     
     /**
      * @brief Inserts a memory element into the program
@@ -65,6 +109,54 @@ public:
      */
     void erase_element(IMemoryElement* element);
     
+    /**
+     * @brief Takes ownership of an element allocated or referenced by the program
+     * 
+     * @param element Newly created element
+     */
+    void adopt_element(PooledPtr<IMemoryElement> element);
+
+    /**
+     * @brief Gives up ownership of an element
+     * 
+     * @param element Element to give up
+     * @return PooledPtr<IMemoryElement> The element, or null if the program doesn't own it
+     */
+    PooledPtr<IMemoryElement> disown_element(const IMemoryElement& element) noexcept;
+
+    /**
+     * @brief Gives up ownership of all elements
+     * 
+     * @return NameMap<PooledPtr<IMemoryElement>> Elements the program owned, by name
+     */
+    NameMap<PooledPtr<IMemoryElement>> disown_elements() noexcept;
+
+    /**
+     * @brief Finds an element owned by this program
+     * 
+     * Unlike find_element, this includes own segments the program has
+     * revoked its access to and excludes segments of other programs.
+     * 
+     * @param name Name of the element
+     * @return IMemoryElement* Pointer to the element, or nullptr if not owned
+     */
+    IMemoryElement* find_owned_element(std::string_view name) const;
+
+    /**
+     * @brief Gets all elements owned by this program
+     * 
+     * @return const NameMap<PooledPtr<IMemoryElement>>& Owned elements by name
+     */
+    const NameMap<PooledPtr<IMemoryElement>>& get_owned_elements() const noexcept;
+
+    /**
+     * @brief Gives up access to other programs' segments and reports leaked elements
+     * 
+     * Called by the manager before the program is deleted; an error is
+     * recorded for every element the program still holds.
+     */
+    void retire();
+    
     /**
      * @brief Creates a reference to another memory element
      * 
@@ -79,6 +171,7 @@ public:
      * 
      * @param type Error type identifier
      * @param description Error description
+     * @throws std::out_of_range If type isn't an error_t value
      */
     void record_error(size_t type, const std::string& description);
     
@@ -89,7 +182,7 @@ public:
      * @return true if destruction was successful
      * @return false if destruction failed
      */
-    bool destroy_element(const std::string& name);
+    bool destroy_element(std::string_view name);
     
     /**
      * @brief Checks if memory can be expanded by the given size
@@ -103,21 +196,70 @@ public:
     /**
      * @brief Gets the total used memory by this program
      * 
+     * Uses UsedMemoryStrategy::Auto, which may run on the TBB thread pool.
+     * 
+     * @return size_t Total used memory in bytes
+     * @throws std::bad_alloc If the parallel sum can't start its tasks
+     */
+    size_t get_used_memory() const;
+
+    /**
+     * @brief Gets the total used memory by this program with a chosen strategy
+     * 
+     * @param strategy How to sum the element sizes
      * @return size_t Total used memory in bytes
      */
-    size_t get_used_memory() const noexcept;
+    size_t get_used_memory(UsedMemoryStrategy strategy) const;
+
+    /**
+     * @brief Gets the number of elements from which UsedMemoryStrategy::Auto sums in parallel
+     * 
+     * @return size_t Current threshold shared by all programs
+     */
+    static size_t get_parallel_threshold() noexcept;
+
+    /**
+     * @brief Sets the number of elements from which UsedMemoryStrategy::Auto sums in parallel
+     * 
+     * @param threshold New threshold shared by all programs
+     */
+    static void set_parallel_threshold(size_t threshold) noexcept;
+
+    /**
+     * @brief Measures where the parallel sum starts to beat the serial one and sets the threshold
+     * 
+     * Times both on synthetic tables of doubling size, from 2^8 up to
+     * 2^20 elements. The threshold is the first size from which the
+     * parallel sum is clearly faster on two consecutive sizes, so timing
+     * noise doesn't flip it. Takes tens of milliseconds, so it's meant to
+     * run once at start-up. Without a second hardware thread, or if the
+     * parallel sum never wins, Auto stays serial.
+     * 
+     * @return size_t New threshold
+     */
+    static size_t calibrate_parallel_threshold();
     
     /**
      * @brief Gets all memory elements owned by this program
      * 
-     * @return const std::unordered_map<std::string, IMemoryElement*>& Const reference to memory elements map
+     * @return const NameMap<IMemoryElement*>& Const reference to memory elements map
+     */
+    const NameMap<IMemoryElement*>& get_memory_elements() const noexcept;
+
+    /**
+     * @brief Finds a memory element visible to this program
+     * 
+     * @param name Name of the element
+     * @return IMemoryElement* Pointer to the element, or nullptr if not found
      */
-    const std::unordered_map<std::string, IMemoryElement*>& get_memory_elements() const noexcept;
+    IMemoryElement* find_element(std::string_view name) const;
     
     /**
      * @brief Destructor for Program
+     * 
+     * Destroys the elements the program still owns.
      */
-    ~Program();
+    ~Program() = default;
 
     /**
      * @brief Allocates a new memory element of specified type
@@ -134,12 +276,13 @@ public:
     template <memory_element_t Descriptor, typename... ExtraArgs>
     Descriptor* allocate_element(const std::string& name, size_t size, ExtraArgs&&... args){
         if(possible_for_expansion(size) == false){
-            manager_.record_error(SIZE_ERROR, "The memory limit in the '" + name_ + "' program has been exceeded.", name_);
+            manager_.record_error(ErrorCode::MemoryLimitExceeded, name_, {name_});
             return nullptr;
         }
         Descriptor* element = manager_.allocate_element<Descriptor>(name, size, *this, args...);
         if(element == nullptr) return nullptr;
-        memory_elements_.insert({name, element});
+        memory_elements_.try_emplace_hashed(element->get_name_hash(), element->get_name(), element);
+        trace_allocation(*element);
         return element;
     }
 };
@@ -0,0 +1,119 @@
+#ifndef PROGRAMSET_HPP
+#define PROGRAMSET_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <Memory/IMemoryElement.hpp>
+
+namespace MemoryNameSpace{
+
+/**
+ * @class ProgramSet
+ * @brief Bitset of program ids
+ *
+ * Program ids are dense, so a set of programs is a bitset indexed by id.
+ * The first 64 ids live in an inline word; higher ids spill into a vector
+ * of words allocated only when such an id is inserted. Membership tests,
+ * insertion and removal are a shift and a mask.
+ */
+class ProgramSet final{
+private:
+    static constexpr size_t WORD_BITS = 64; ///< Bits per word
+
+    uint64_t inline_ = 0;             ///< Ids [0, 64)
+    std::vector<uint64_t> overflow_;  ///< Ids from 64 on, one word per 64 ids
+    size_t size_ = 0;                 ///< Number of ids in the set
+
+    /**
+     * @brief Gets the word holding an id, or nullptr if it isn't allocated
+     */
+    const uint64_t* word(ProgramId id) const noexcept {
+        if(id < WORD_BITS) return &inline_;
+        size_t index = id / WORD_BITS - 1;
+        return index < overflow_.size() ? &overflow_[index] : nullptr;
+    }
+
+public:
+    /**
+     * @brief Checks whether an id is in the set
+     *
+     * @param id Program id
+     * @return true if the id is in the set
+     */
+    bool contains(ProgramId id) const noexcept {
+        const uint64_t* bits = word(id);
+        return bits != nullptr && ((*bits >> (id % WORD_BITS)) & 1) != 0;
+    }
+
+    /**
+     * @brief Adds an id to the set
+     *
+     * @param id Program id
+     * @return true if the id was added, false if it was already present
+     */
+    bool insert(ProgramId id){
+        uint64_t* bits = &inline_;
+        if(id >= WORD_BITS){
+            size_t index = id / WORD_BITS - 1;
+            if(index >= overflow_.size()) overflow_.resize(index + 1, 0);
+            bits = &overflow_[index];
+        }
+        uint64_t mask = uint64_t{1} << (id % WORD_BITS);
+        if((*bits & mask) != 0) return false;
+        *bits |= mask;
+        ++size_;
+        return true;
+    }
+
+    /**
+     * @brief Removes an id from the set
+     *
+     * @param id Program id
+     * @return true if the id was removed, false if it wasn't present
+     */
+    bool erase(ProgramId id) noexcept {
+        uint64_t* bits = &inline_;
+        if(id >= WORD_BITS){
+            size_t index = id / WORD_BITS - 1;
+            if(index >= overflow_.size()) return false;
+            bits = &overflow_[index];
+        }
+        uint64_t mask = uint64_t{1} << (id % WORD_BITS);
+        if((*bits & mask) == 0) return false;
+        *bits &= ~mask;
+        --size_;
+        return true;
+    }
+
+    /**
+     * @brief Gets the number of ids in the set
+     */
+    size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Checks whether the set is empty
+     */
+    bool empty() const noexcept { return size_ == 0; }
+
+    /**
+     * @brief Calls a function for each id in ascending order
+     *
+     * @param function Callable invoked as function(ProgramId)
+     */
+    template<typename F>
+    void for_each(F&& function) const {
+        auto visit = [&function](uint64_t bits, size_t base){
+            for(; bits != 0; bits &= bits - 1)
+                function(static_cast<ProgramId>(base + std::countr_zero(bits)));
+        };
+        visit(inline_, 0);
+        for(size_t i = 0; i < overflow_.size(); ++i)
+            visit(overflow_[i], (i + 1) * WORD_BITS);
+    }
+};
+
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <memory>
+#include <utility>
 #include <Memory/IMemoryElement.hpp>
 #include <Memory/Program.hpp>
 
@@ -33,17 +34,18 @@ class IBuffer;
  */
 class ReferenceDescriptor final : public IMemoryElement{
 private:
-    std::string name_;         ///< Name of the reference
-    std::string target_name_;  ///< Name of the target memory element
+    const InternedName* name_;        ///< Interned name of the reference
+    const InternedName* target_name_; ///< Interned name of the target memory element
+    IMemoryElement* target_;   ///< Resolved target element, nullptr once the target is destroyed
     IManager& manager_;        ///< Reference to the memory manager
 
 private:
     /**
      * @brief Gets the target memory element
      * 
-     * @return IMemoryElement* Pointer to target element, or nullptr if not found
+     * @return IMemoryElement* Pointer to target element, or nullptr if it was destroyed
      */
-    IMemoryElement* get_element() const;
+    IMemoryElement* get_element() const noexcept;
 
 public:
     /**
@@ -51,17 +53,49 @@ public:
      * 
      * @param name Name of the reference
      * @param target_name Name of the target memory element
+     * @param target Resolved target memory element
      * @param manager Reference to the memory manager
      */
-    ReferenceDescriptor(const std::string& name, const std::string& target_name, IManager& manager)
-            : name_(name), target_name_(target_name), manager_(manager) {};
+    ReferenceDescriptor(const std::string& name, const std::string& target_name, IMemoryElement* target, IManager& manager)
+            : IMemoryElement(ElementKind::Reference), name_(&manager.intern_name(name)), target_name_(&manager.intern_name(target_name)), target_(target), manager_(manager) {};
+
+    /**
+     * @brief Takes over the interned names of another reference
+     * 
+     * @param other Reference left without names
+     */
+    ReferenceDescriptor(ReferenceDescriptor&& other) noexcept
+            : IMemoryElement(other), name_(std::exchange(other.name_, nullptr)), target_name_(std::exchange(other.target_name_, nullptr)), target_(other.target_), manager_(other.manager_) {}
+
+    ReferenceDescriptor(const ReferenceDescriptor&) = delete;
+    ReferenceDescriptor& operator=(const ReferenceDescriptor&) = delete;
+
+    /**
+     * @brief Gives the interned names back to the manager
+     */
+    ~ReferenceDescriptor() override;
     
+    /**
+     * @brief Checks whether a kind denotes a ReferenceDescriptor
+     * 
+     * @param kind Kind to check
+     * @return true if kind is ElementKind::Reference
+     */
+    static constexpr bool has_kind(ElementKind kind) noexcept { return kind == ElementKind::Reference; }
+
     /**
      * @brief Gets the name of the reference
      * 
      * @return const std::string& Reference to the reference name
      */
     const std::string& get_name() const noexcept override;
+
+    /**
+     * @brief Gets the precomputed hash of the reference name
+     * 
+     * @return size_t Hash of the reference name
+     */
+    size_t get_name_hash() const noexcept override;
     
     /**
      * @brief Gets the size of the referenced element
@@ -98,6 +132,20 @@ public:
      * @return false if target element doesn't exist
      */
     bool is_valid() const noexcept;
+
+    /**
+     * @brief Gets the target element the reference is bound to
+     * 
+     * @return const IMemoryElement* Pointer to target element, or nullptr if it was destroyed
+     */
+    const IMemoryElement* get_target() const noexcept;
+
+    /**
+     * @brief Detaches the reference from its destroyed target
+     * 
+     * Called by the manager when the target element is destroyed.
+     */
+    void invalidate() noexcept;
     
     /**
      * @brief Gets raw bytes from the referenced element
@@ -135,13 +183,6 @@ public:
      */
     bool destroy(Program& prog) override;
     
-    /**
-     * @brief Checks if this is a reference element
-     * 
-     * @return true (ReferenceDescriptor is always a reference)
-     */
-    bool is_reference() const noexcept override;
-    
     /**
      * @brief Gets the name of the target element
      * 
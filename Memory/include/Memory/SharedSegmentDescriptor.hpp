@@ -2,10 +2,15 @@
 #define SHAREDSEGMENTDESCRIPTOR_HPP
 
 #include <string>
+#include <string_view>
+#include <span>
 #include <unordered_map>
 #include <algorithm>
+#include <cstring>
+#include <type_traits>
 #include <Memory/ArrayDescriptor.hpp>
 #include <Memory/Program.hpp>
+#include <Memory/ProgramSet.hpp>
 
 namespace MemoryNameSpace{
 
@@ -18,8 +23,37 @@ namespace MemoryNameSpace{
  * programs have access to the segment and manages access permissions.
  */
 class SharedSegmentDescriptor final: public ArrayDescriptor{
+public:
+    static constexpr size_t CACHE_LINE = 64;         ///< Alignment of chunk boundaries in bytes
+    static constexpr size_t CHUNK_BYTES = 16 * 1024; ///< Target size of a parallel chunk in bytes
+
 private:
-    std::unordered_map<std::string, const Program*> programs_; ///< Map of programs with access to this segment
+    ProgramSet programs_; ///< Ids of programs with access to this segment
+
+    /**
+     * @brief Type-erased chunk callback
+     */
+    using ChunkCallback = void (*)(void* context, std::byte* data, size_t count);
+
+    /**
+     * @brief Checks program access and records an error if it is denied
+     * 
+     * @param prog Name of the program
+     * @return true if the program has access
+     * @return false if access is denied (error recorded)
+     */
+    bool check_access_with_error(std::string_view prog) const;
+
+    /**
+     * @brief Splits a range into cache-line-aligned chunks and processes them in parallel
+     * 
+     * @param data First element of the range
+     * @param count Number of elements
+     * @param elem_size Size of an element in bytes
+     * @param callback Function called for each chunk
+     * @param context Context passed to the callback
+     */
+    static void run_chunks(std::byte* data, size_t count, size_t elem_size, ChunkCallback callback, void* context);
 
 public:
     /**
@@ -33,8 +67,17 @@ public:
      * @param manager Reference to the memory manager
      */
     SharedSegmentDescriptor(const std::string& name, size_t size, size_t offset, size_t element_size, const Program* program, IManager& manager)
-            : ArrayDescriptor(name, size, offset, element_size, manager)
-            , programs_(std::unordered_map<std::string, const Program*>{{program->get_name(), program}}) {};
+            : ArrayDescriptor(ElementKind::Shared, name, size, offset, element_size, manager), programs_() {
+        programs_.insert(program->get_id());
+    };
+
+    /**
+     * @brief Checks whether a kind denotes a SharedSegmentDescriptor
+     * 
+     * @param kind Kind to check
+     * @return true if kind is ElementKind::Shared
+     */
+    static constexpr bool has_kind(ElementKind kind) noexcept { return kind == ElementKind::Shared; }
     
     /**
      * @brief Grants access to the shared segment for a program
@@ -57,7 +100,16 @@ public:
      * @return true if program has access
      * @return false if program doesn't have access
      */
-    bool check_access(const std::string& name) const;
+    bool check_access(std::string_view name) const;
+
+    /**
+     * @brief Checks if a program has access to this segment
+     * 
+     * @param program Id of program to check
+     * @return true if program has access
+     * @return false if program doesn't have access
+     */
+    bool check_access(ProgramId program) const noexcept { return programs_.contains(program); }
     
     /**
      * @brief Checks if the segment can be destroyed by the specified program
@@ -77,6 +129,71 @@ public:
      * @return false if multiple programs have access
      */
     bool is_last() const;
+
+    /**
+     * @brief Gets the programs with access to the segment
+     * 
+     * @return const ProgramSet& Ids of programs with access
+     */
+    const ProgramSet& get_programs() const noexcept;
+
+    /**
+     * @brief Calls a function for every chunk of the segment in parallel
+     * 
+     * Access of the program is checked once per call. The segment is split
+     * into chunks of about CHUNK_BYTES whose boundaries fall on cache lines,
+     * and the chunks are processed with tbb::parallel_for. The function is
+     * called concurrently, so it must be safe to run from several threads.
+     * 
+     * @tparam T Element type (must be trivially copyable and match the element size)
+     * @param prog Name of the program requesting the operation
+     * @param function Callable invoked as function(std::span<T>)
+     * @return true if the segment was processed
+     * @return false if the program has no access (error recorded)
+     * @throws std::runtime_error If the type size doesn't match the element size
+     *         or the data isn't suitably aligned for T
+     */
+    template<typename T, typename F>
+    bool for_each_chunk(std::string_view prog, F&& function){
+        if(!check_access_with_error(prog)) return false;
+        std::span<T> data = typed_span<T>(manager_.get_data());
+        ChunkCallback callback = [](void* context, std::byte* chunk, size_t count){
+            (*static_cast<std::remove_reference_t<F>*>(context))(std::span<T>(reinterpret_cast<T*>(chunk), count));
+        };
+        run_chunks(reinterpret_cast<std::byte*>(data.data()), data.size(), sizeof(T), callback, &function);
+        return true;
+    }
+
+    /**
+     * @brief Replaces every element of the segment by op(element) in parallel
+     * 
+     * Elements are read and written through memcpy, so the segment may
+     * start at any offset.
+     * 
+     * @tparam T Element type (must be trivially copyable and match the element size)
+     * @param prog Name of the program requesting the operation
+     * @param op Callable invoked as op(T) -> T, concurrently from several threads
+     * @return true if the segment was transformed
+     * @return false if the program has no access (error recorded)
+     * @throws std::runtime_error If the type size doesn't match the element size
+     */
+    template<typename T, typename Op>
+    bool transform(std::string_view prog, Op op){
+        static_assert(std::is_trivially_copyable_v<T>, "SharedSegmentDescriptor::transform<T> requires trivially copyable type T.");
+        if(!check_access_with_error(prog)) return false;
+        size_t count = typed_length<T>();
+        ChunkCallback callback = [](void* context, std::byte* chunk, size_t count){
+            Op& op = *static_cast<Op*>(context);
+            for(std::byte* end = chunk + count * sizeof(T); chunk != end; chunk += sizeof(T)){
+                T value;
+                std::memcpy(&value, chunk, sizeof(T));
+                value = op(value);
+                std::memcpy(chunk, &value, sizeof(T));
+            }
+        };
+        run_chunks(element_data(0), count, sizeof(T), callback, &op);
+        return true;
+    }
 };
 
 }
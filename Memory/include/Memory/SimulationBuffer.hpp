@@ -0,0 +1,170 @@
+#ifndef SIMULATION_BUFFER_HPP
+#define SIMULATION_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+#include <Memory/Buffer.hpp>
+
+namespace MemoryNameSpace{
+
+/**
+ * @enum AllocatorPolicy
+ * @brief Strategies for choosing the free block of an allocation
+ */
+enum class AllocatorPolicy : uint8_t {
+    FirstFit,  ///< Lowest-addressed block that fits (what Buffer does)
+    BestFit,   ///< Smallest block that fits, lowest address among equals
+    WorstFit   ///< Largest block, lowest address among equals
+};
+
+/**
+ * @class SimulationBuffer
+ * @brief Buffer that tracks block metadata only, for capacity planning
+ *
+ * SimulationBuffer keeps the free list of a buffer of any runtime
+ * capacity without backing storage, so a 64 GiB arena costs only its
+ * free-list metadata. Free blocks are indexed by offset and by size,
+ * which keeps best and worst fit logarithmic.
+ *
+ * get_data returns nullptr. A manager built on it can allocate, destroy
+ * and defragment (nothing is moved), but element values must not be
+ * read or written:
+ *
+ * @code
+ * Manager<0> manager(std::make_unique<SimulationBuffer>(size_t{64} << 30, AllocatorPolicy::BestFit));
+ * @endcode
+ */
+class SimulationBuffer final : public IBuffer{
+private:
+    size_t capacity_;                              ///< Simulated capacity in bytes
+    AllocatorPolicy policy_;                       ///< Strategy for choosing a free block
+    std::map<size_t, size_t> by_offset_;           ///< Sizes of the free blocks by offset
+    std::set<std::pair<size_t, size_t>> by_size_;  ///< (size, offset) of the free blocks
+    size_t free_bytes_;                            ///< Total size of the free blocks
+    mutable std::vector<Block> blocks_;            ///< Free blocks ordered by offset, rebuilt on demand
+    mutable bool blocks_dirty_ = false;            ///< Whether blocks_ is out of date
+
+    /**
+     * @brief Adds a free block to both indexes
+     */
+    void insert_free(size_t offset, size_t size);
+
+    /**
+     * @brief Removes the free block at an offset from both indexes
+     */
+    void erase_free(std::map<size_t, size_t>::iterator block);
+
+    /**
+     * @brief Finds the free block an allocation takes under the policy
+     *
+     * @return Iterator into by_offset_, or its end if no block fits
+     */
+    std::map<size_t, size_t>::iterator choose_block(size_t size, size_t alignment);
+
+public:
+    /**
+     * @brief Constructs a buffer with a single free block covering the capacity
+     *
+     * @param capacity Simulated capacity in bytes
+     * @param policy Strategy for choosing a free block
+     */
+    explicit SimulationBuffer(size_t capacity, AllocatorPolicy policy = AllocatorPolicy::FirstFit);
+
+    /**
+     * @brief Gets raw data buffer pointer
+     *
+     * @return std::byte* Always nullptr: there is no backing storage
+     */
+    std::byte* get_data() noexcept override { return nullptr; }
+
+    /**
+     * @brief Gets raw data buffer pointer (const version)
+     *
+     * @return const std::byte* Always nullptr: there is no backing storage
+     */
+    const std::byte* get_data() const noexcept override { return nullptr; }
+
+    /**
+     * @brief Gets the simulated capacity
+     *
+     * @return size_t Capacity in bytes
+     */
+    size_t get_capacity() const noexcept override { return capacity_; }
+
+    /**
+     * @brief Gets the allocator policy
+     *
+     * @return AllocatorPolicy Strategy for choosing a free block
+     */
+    AllocatorPolicy get_policy() const noexcept { return policy_; }
+
+    /**
+     * @brief Allocates a block without throwing
+     *
+     * Padding in front of an aligned block is kept as a free block of its own.
+     *
+     * @param size Size to allocate in bytes
+     * @param alignment Required alignment of the offset (not 0)
+     * @return std::expected<size_t, BufferError> Offset of allocated block, or BufferError::Overflow
+     */
+    std::expected<size_t, BufferError> try_allocate_block(size_t size, size_t alignment = 1) noexcept override;
+
+    /**
+     * @brief Destroys a block and merges it with adjacent free blocks
+     *
+     * @param offset Offset of block to destroy
+     * @param size Size of block to destroy
+     * @return std::expected<void, BufferError> Nothing, or BufferError::OutOfRange / BufferError::DoubleFree
+     * @throws std::bad_alloc If a separate free block can't be recorded; the buffer is left unchanged
+     */
+    std::expected<void, BufferError> try_destroy_block(size_t offset, size_t size) override;
+
+    /**
+     * @brief Gets the list of free blocks
+     *
+     * The list is rebuilt from the offset index after changes, so it
+     * costs a pass over the free blocks; the counters don't.
+     *
+     * @return const std::vector<Block>& Free blocks ordered by offset
+     * @throws std::bad_alloc If the list can't be rebuilt
+     */
+    const std::vector<Block>& get_blocks() const override;
+
+    /**
+     * @brief Gets the number of free blocks
+     *
+     * @return size_t Number of free blocks
+     */
+    size_t get_free_block_count() const noexcept override { return by_offset_.size(); }
+
+    /**
+     * @brief Replaces the free list after allocated blocks were packed to the front
+     *
+     * @param used Bytes occupied by the packed blocks; [used, capacity) becomes one free block
+     */
+    void compact(size_t used) override;
+
+    /**
+     * @brief Gets the number of free bytes
+     *
+     * @return size_t Sum of the sizes of all free blocks
+     */
+    size_t get_free_memory() const noexcept override { return free_bytes_; }
+
+    /**
+     * @brief Gets the size of the largest free block
+     *
+     * @return size_t Size in bytes, or 0 if the buffer is full
+     */
+    size_t get_largest_free_block() const noexcept override {
+        return by_size_.empty() ? 0 : by_size_.rbegin()->first;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef SYSTEMREPORT_HPP
+#define SYSTEMREPORT_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include <Memory/IMemoryElement.hpp>
+#include <Memory/IManager.hpp>
+
+namespace MemoryNameSpace{
+
+/**
+ * @brief Number of element slots and free blocks from which the report pass runs on the TBB thread pool
+ */
+inline constexpr size_t REPORT_PARALLEL_THRESHOLD = 1 << 14;
+
+/**
+ * @brief Number of size classes of the free block histogram
+ */
+inline constexpr size_t FREE_BLOCK_CLASSES = 64;
+
+/**
+ * @brief Number of element kinds
+ */
+inline constexpr size_t ELEMENT_KINDS = 4;
+
+/**
+ * @struct SegmentFanOut
+ * @brief Number of programs sharing a segment
+ */
+struct SegmentFanOut{
+    ElementId id = INVALID_ELEMENT_ID;  ///< Id of the segment
+    size_t size = 0;                    ///< Size of the segment in bytes
+    size_t programs = 0;                ///< Number of programs with access
+};
+
+/**
+ * @struct SystemReport
+ * @brief System-wide analytics gathered in one pass over elements and free blocks
+ */
+struct SystemReport{
+    std::vector<size_t> program_usage;                         ///< Bytes of own elements and accessible segments, indexed by ProgramId
+    std::array<size_t, ELEMENT_KINDS> kind_usage{};            ///< Bytes by ElementKind
+    std::array<size_t, ELEMENT_KINDS> kind_count{};            ///< Elements by ElementKind
+    std::vector<SegmentFanOut> segments;                       ///< Shared segments ordered by id
+    size_t dangling_references = 0;                            ///< References whose target has been destroyed
+    std::array<size_t, FREE_BLOCK_CLASSES> free_block_histogram{}; ///< Free blocks with size in [2^i, 2^(i+1)) in class i
+    size_t used = 0;                                           ///< Bytes in elements
+    size_t free = 0;                                           ///< Bytes in free blocks
+    size_t largest_free_block = 0;                             ///< Size of the largest free block
+    std::array<size_t, ERROR_TYPE_COUNT> errors{};             ///< Kept errors by error_t
+    std::array<size_t, ERROR_TYPE_COUNT> errors_total{};       ///< Errors ever reported by error_t
+    bool parallel = false;                                     ///< Whether the pass ran on the TBB thread pool
+};
+
+/**
+ * @brief Builds a report of the whole system
+ *
+ * Element slots and free blocks are scanned in a single pass, as one
+ * range split between TBB tasks when there are at least
+ * parallel_threshold of them; smaller systems are scanned serially,
+ * where task start-up would cost more than the scan. The manager must
+ * not be modified while the report is built.
+ *
+ * @param manager Manager to report on
+ * @param parallel_threshold Slots plus free blocks from which the pass runs in parallel
+ * @return SystemReport Usage, fan-out, fragmentation and error counts
+ */
+SystemReport make_system_report(const IManager& manager, size_t parallel_threshold = REPORT_PARALLEL_THRESHOLD);
+
+}
+
+#endif
@@ -0,0 +1,221 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <iosfwd>
+#include <span>
+#include <vector>
+#include <Memory/IMemoryElement.hpp>
+
+namespace MemoryNameSpace{
+
+class IBuffer;
+class IManager;
+
+/**
+ * @enum TraceOp
+ * @brief Kinds of events in an allocation trace
+ */
+enum class TraceOp : uint8_t {
+    Allocate,   ///< Element allocated with size bytes
+    Free,       ///< Element freed
+    Resize,     ///< Element reallocated with size bytes
+    Defragment  ///< Memory defragmented
+};
+
+/**
+ * @struct TraceEvent
+ * @brief One event of an allocation trace
+ *
+ * Elements are identified by a handle assigned on allocation, so a trace
+ * carries no names.
+ */
+struct TraceEvent{
+    uint64_t timestamp = 0;                 ///< Nanoseconds since the start of the trace
+    uint64_t size = 0;                      ///< Size in bytes (Allocate and Resize)
+    uint32_t element = 0;                   ///< Handle of the element (unused for Defragment)
+    ProgramId program = 0;                  ///< Program that issued the event
+    TraceOp op = TraceOp::Allocate;         ///< Kind of event
+    ElementKind kind = ElementKind::Variable; ///< Kind of the element (Allocate and Resize)
+};
+
+/**
+ * @enum TraceError
+ * @brief Reasons a trace can't be read
+ */
+enum class TraceError : uint8_t {
+    BadMagic,            ///< Stream doesn't start with the trace signature
+    UnsupportedVersion,  ///< Trace was written by a newer format version
+    Truncated,           ///< Stream ends inside an event
+    Corrupted            ///< Event has an unknown kind or an oversized field
+};
+
+/**
+ * @brief Writes events in the binary trace format
+ *
+ * The format is a signature and version followed by the event count and
+ * the events. Each event is a byte holding the operation and element kind
+ * followed by LEB128 varints: timestamp delta, program, element and, for
+ * Allocate and Resize, size. A typical event takes 5 to 8 bytes.
+ *
+ * @param out Binary output stream
+ * @param events Events in timestamp order
+ */
+void write_trace(std::ostream& out, std::span<const TraceEvent> events);
+
+/**
+ * @brief Reads events written by write_trace
+ *
+ * @param in Binary input stream
+ * @return std::expected<std::vector<TraceEvent>, TraceError> Events, or the reason the trace is invalid
+ */
+std::expected<std::vector<TraceEvent>, TraceError> read_trace(std::istream& in);
+
+/**
+ * @class TraceRecorder
+ * @brief Collects allocation events of a manager's programs
+ *
+ * Attached with IManager::set_trace_recorder; programs then report every
+ * successful allocation and destruction and the manager every
+ * defragmentation. References are not recorded: they own no memory.
+ */
+class TraceRecorder final{
+private:
+    static constexpr uint32_t NO_HANDLE = UINT32_MAX;  ///< Marks element ids without a live handle
+
+    std::chrono::steady_clock::time_point start_;  ///< Time of timestamp 0
+    std::vector<TraceEvent> events_;               ///< Recorded events
+    std::vector<uint32_t> handles_;                ///< Handles of live elements indexed by ElementId
+    uint32_t next_handle_ = 0;                     ///< Handle of the next allocated element
+
+    /**
+     * @brief Gets the time since the start of the recording
+     */
+    uint64_t now() const noexcept;
+
+public:
+    /**
+     * @brief Constructs an empty recorder; timestamps count from now
+     */
+    TraceRecorder();
+
+    /**
+     * @brief Records an allocation
+     *
+     * @param program Program that allocated the element
+     * @param element Allocated element
+     */
+    void record_allocate(ProgramId program, const IMemoryElement& element);
+
+    /**
+     * @brief Records a destruction
+     *
+     * Elements allocated before the recorder was attached are ignored.
+     *
+     * @param program Program that destroyed the element
+     * @param element Id the element had in the element table
+     */
+    void record_free(ProgramId program, ElementId element);
+
+    /**
+     * @brief Records a defragmentation
+     */
+    void record_defragment();
+
+    /**
+     * @brief Gets the recorded events
+     */
+    const std::vector<TraceEvent>& get_events() const noexcept { return events_; }
+};
+
+/**
+ * @struct TraceWorkload
+ * @brief Parameters of a synthetic trace
+ *
+ * Sizes follow a lognormal distribution and lifetimes an exponential
+ * one, which matches the skew of real allocation traffic: most blocks
+ * are small and short-lived, a few are large or live long.
+ */
+struct TraceWorkload{
+    size_t allocations = 10000;          ///< Number of allocations
+    double size_log_mean = 5.0;          ///< Mean of the log of the size (e^5 ~ 148 bytes median)
+    double size_log_sigma = 1.0;         ///< Standard deviation of the log of the size
+    size_t max_size = 1 << 20;           ///< Sizes are clamped to [1, max_size]
+    double mean_lifetime = 100.0;        ///< Mean lifetime in allocations
+    uint64_t interval = 1000;            ///< Nanoseconds between allocations
+    uint32_t programs = 1;               ///< Allocations are spread over programs [0, programs)
+    size_t defragment_every = 0;         ///< Defragment after every that many allocations (0 for never)
+    uint64_t seed = 1;                   ///< Seed of the random generator
+};
+
+/**
+ * @brief Generates a synthetic trace
+ *
+ * Every allocated element is freed, either when its lifetime expires or
+ * at the end of the trace.
+ *
+ * @param workload Parameters of the trace
+ * @return std::vector<TraceEvent> Events in timestamp order
+ */
+std::vector<TraceEvent> generate_trace(const TraceWorkload& workload);
+
+/**
+ * @struct LatencySummary
+ * @brief Latency percentiles of one kind of operation
+ */
+struct LatencySummary{
+    size_t count = 0;   ///< Number of operations
+    uint64_t p50 = 0;   ///< Median in nanoseconds
+    uint64_t p90 = 0;   ///< 90th percentile in nanoseconds
+    uint64_t p99 = 0;   ///< 99th percentile in nanoseconds
+    uint64_t max = 0;   ///< Slowest operation in nanoseconds
+};
+
+/**
+ * @struct ReplayResult
+ * @brief Outcome of replaying a trace
+ */
+struct ReplayResult{
+    size_t events = 0;                   ///< Events replayed
+    size_t failed = 0;                   ///< Allocations that failed and frees of their elements
+    uint64_t elapsed = 0;                ///< Total time of the operations in nanoseconds
+    double throughput = 0.0;             ///< Events per second
+    LatencySummary allocate;             ///< Latencies of allocations (and the allocating half of resizes)
+    LatencySummary free;                 ///< Latencies of frees (and the freeing half of resizes)
+    LatencySummary defragment;           ///< Latencies of defragmentations
+    size_t peak_used = 0;                ///< Largest number of used bytes
+    double peak_fragmentation = 0.0;     ///< Largest 1 - largest free block / free bytes
+};
+
+/**
+ * @brief Replays a trace against a buffer
+ *
+ * Defragment events pack the live blocks to the front and compact the
+ * free list. Program ids and element kinds are ignored.
+ *
+ * @param events Trace to replay
+ * @param buffer Buffer to allocate from
+ * @return ReplayResult Throughput, latencies and peaks
+ */
+ReplayResult replay_trace(std::span<const TraceEvent> events, IBuffer& buffer);
+
+/**
+ * @brief Replays a trace against a manager
+ *
+ * A program named trace_<id> is added for every program id of the trace,
+ * with a memory limit of the whole buffer. Elements are allocated with
+ * the descriptor of their kind and destroyed by name, so the replay
+ * includes the manager's bookkeeping.
+ *
+ * @param events Trace to replay
+ * @param manager Manager to allocate from; should have no programs named trace_<id>
+ * @return ReplayResult Throughput, latencies and peaks
+ */
+ReplayResult replay_trace(std::span<const TraceEvent> events, IManager& manager);
+
+}
+
+#endif
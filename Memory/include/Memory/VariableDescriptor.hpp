@@ -3,6 +3,11 @@
 
 #include <string>
 #include <cstddef>
+#include <memory>
+#include <span>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
 #include <Memory/MemoryElement.hpp>
 
 namespace MemoryNameSpace{
@@ -12,9 +17,62 @@ namespace MemoryNameSpace{
  * @brief Descriptor for simple variable memory elements
  * 
  * VariableDescriptor represents simple, non-array memory elements.
- * It inherits all functionality from MemoryElement without modification.
+ * Besides whole-value access inherited from MemoryElement it supports
+ * partial access to byte ranges and to fields of record types, which
+ * moves only the touched bytes.
  */
 class VariableDescriptor final : public MemoryElement{
+private:
+    /**
+     * @brief Validates a byte range of the variable
+     * 
+     * @param begin Starting byte offset
+     * @param count Number of bytes
+     * @return true if the range lies within the variable
+     * @return false if the range is out of bounds (error recorded)
+     */
+    bool check_bytes(size_t begin, size_t count) const;
+
+    /**
+     * @brief Gets the address of a byte of the variable in the buffer
+     * 
+     * @param begin Byte offset within the variable
+     * @return std::byte* Pointer to the byte
+     * @throws std::runtime_error If the buffer has no storage
+     */
+    std::byte* byte_data(size_t begin) const;
+
+    /**
+     * @brief Computes the byte offset of a data member
+     * 
+     * The offset is measured on a value-initialized Record, so no inactive
+     * storage is ever read through the member pointer.
+     * 
+     * @param member Pointer to the data member
+     * @return size_t Offset of the member within Record
+     */
+    template<typename Record, typename Field>
+    static size_t member_offset(Field Record::* member) {
+        static_assert(std::is_standard_layout_v<Record> && std::is_default_constructible_v<Record>,
+                      "VariableDescriptor member access requires a default-constructible standard-layout record.");
+        const Record record{};
+        return static_cast<size_t>(reinterpret_cast<const std::byte*>(std::addressof(record.*member)) -
+                                   reinterpret_cast<const std::byte*>(std::addressof(record)));
+    }
+
+    /**
+     * @brief Checks that a record type describes the whole variable
+     * 
+     * @throws std::runtime_error If sizeof(Record) doesn't match the variable size
+     */
+    template<typename Record>
+    void check_record() const {
+        static_assert(std::is_trivially_copyable_v<Record> && std::is_standard_layout_v<Record>,
+                      "VariableDescriptor member access requires a trivially copyable standard-layout record.");
+        if(get_size() != sizeof(Record))
+            throw std::runtime_error("Size mismatch in VariableDescriptor member access.");
+    }
+
 public:
     /**
      * @brief Constructs a new VariableDescriptor object
@@ -25,7 +83,91 @@ public:
      * @param manager Reference to the memory manager
      */
     VariableDescriptor(const std::string& name, size_t size, size_t offset, IManager& manager)
-            : MemoryElement(name, size, offset, manager) {};
+            : MemoryElement(ElementKind::Variable, name, size, offset, size, manager) {};
+
+    /**
+     * @brief Checks whether a kind denotes a VariableDescriptor
+     * 
+     * @param kind Kind to check
+     * @return true if kind is ElementKind::Variable
+     */
+    static constexpr bool has_kind(ElementKind kind) noexcept { return kind == ElementKind::Variable; }
+
+    /**
+     * @brief Copies a byte range out of the variable
+     * 
+     * @param begin Starting byte offset
+     * @param out Destination for out.size() bytes
+     * @return true if the bytes were copied
+     * @return false if the range is out of bounds (error recorded)
+     */
+    bool read_bytes(size_t begin, std::span<std::byte> out) const;
+
+    /**
+     * @brief Copies bytes into a range of the variable
+     * 
+     * @param begin Starting byte offset
+     * @param bytes Bytes to write
+     * @return true if the bytes were written
+     * @return false if the range is out of bounds (error recorded)
+     */
+    bool write_bytes(size_t begin, std::span<const std::byte> bytes);
+
+    /**
+     * @brief Reads a field stored at a byte offset
+     * 
+     * @tparam T Field type (must be trivially copyable)
+     * @param offset Byte offset of the field
+     * @return std::optional<T> Field value, or nullopt if out of bounds (error recorded)
+     */
+    template<typename T>
+    std::optional<T> get_field(size_t offset) const {
+        static_assert(std::is_trivially_copyable_v<T>, "VariableDescriptor::get_field<T> requires trivially copyable type T.");
+        T value;
+        if(!read_bytes(offset, std::as_writable_bytes(std::span<T, 1>(&value, 1)))) return std::nullopt;
+        return value;
+    }
+
+    /**
+     * @brief Writes a field stored at a byte offset
+     * 
+     * @tparam T Field type (must be trivially copyable)
+     * @param offset Byte offset of the field
+     * @param value Value to store
+     * @return true if the field was written
+     * @return false if out of bounds (error recorded)
+     */
+    template<typename T>
+    bool set_field(size_t offset, const T& value){
+        static_assert(std::is_trivially_copyable_v<T>, "VariableDescriptor::set_field<T> requires trivially copyable type T.");
+        return write_bytes(offset, std::as_bytes(std::span<const T, 1>(&value, 1)));
+    }
+
+    /**
+     * @brief Reads a data member of the record stored in the variable
+     * 
+     * @param member Pointer to the data member, e.g. &Record::field
+     * @return Field Value of the member
+     * @throws std::runtime_error If sizeof(Record) doesn't match the variable size
+     */
+    template<typename Record, typename Field>
+    Field get_member(Field Record::* member) const {
+        check_record<Record>();
+        return *get_field<Field>(member_offset(member));
+    }
+
+    /**
+     * @brief Writes a data member of the record stored in the variable
+     * 
+     * @param member Pointer to the data member, e.g. &Record::field
+     * @param value Value to store
+     * @throws std::runtime_error If sizeof(Record) doesn't match the variable size
+     */
+    template<typename Record, typename Field>
+    void set_member(Field Record::* member, const Field& value){
+        check_record<Record>();
+        set_field(member_offset(member), value);
+    }
 };
 
 }
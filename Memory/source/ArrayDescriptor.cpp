@@ -1,25 +1,48 @@
 #include <Memory/ArrayDescriptor.hpp>
+#include <stdexcept>
 
 namespace MemoryNameSpace{
 
-size_t ArrayDescriptor::get_elem_size() const noexcept { return element_size_; }
+size_t ArrayDescriptor::get_elem_size() const noexcept { return table_.get_elem_size(id_); }
+
+bool ArrayDescriptor::check_range(size_t begin, size_t end, size_t type_size) const {
+    size_t element_size = table_.get_elem_size(id_);
+    if(element_size != type_size)
+        throw std::runtime_error("Size mismatch in ArrayDescriptor range access.");
+    size_t count = table_.get_size(id_) / element_size;
+    if(end < begin || end > count){
+        manager_.record_error(ErrorCode::RangeOutOfBounds, get_owner_name(), ErrorContext{get_name(), {}, {begin, end, count}});
+        return false;
+    }
+    return true;
+}
+
+void ArrayDescriptor::record_length_mismatch(const ArrayDescriptor& other) const {
+    manager_.record_error(ErrorCode::LengthMismatch, get_owner_name(), ErrorContext{get_name(), other.get_name(), {}});
+}
+
+std::byte* ArrayDescriptor::element_data(size_t index) const {
+    return raw_data() + index * table_.get_elem_size(id_);
+}
 
 void ArrayDescriptor::get_raw_value(std::byte *value, size_t begin, size_t end) const {
-    std::byte* target = manager_.get_data() + offset_ + begin * element_size_;
+    size_t element_size = table_.get_elem_size(id_);
+    std::byte* target = raw_data() + begin * element_size;
     if(end == 0){
-        std::copy(target, target + element_size_, value);
+        std::copy(target, target + element_size, value);
         return;
     }
-    std::copy(target, target + element_size_ * (end - begin), value);
+    std::copy(target, target + element_size * (end - begin), value);
 }
 
 void ArrayDescriptor::set_raw_value(const std::byte *value, size_t begin, size_t end){
-    std::byte* target = manager_.get_data() + offset_ + begin * element_size_;
+    size_t element_size = table_.get_elem_size(id_);
+    std::byte* target = raw_data() + begin * element_size;
     if(end == 0){
-        std::copy(value, value + element_size_, target);
+        std::copy(value, value + element_size, target);
         return;
     }
-    std::copy(value, value + element_size_ * (end - begin), target);
+    std::copy(value, value + element_size * (end - begin), target);
 }
 
-}
\ No newline at end of file
+}
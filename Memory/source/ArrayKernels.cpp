@@ -0,0 +1,353 @@
+#include <Memory/ArrayKernels.hpp>
+#include <cstring>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_scan.h>
+#include <tbb/blocked_range.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MEMORY_KERNELS_X86 1
+#endif
+
+#define KERNEL_INLINE inline __attribute__((always_inline))
+#define KERNEL_AVX2 __attribute__((target("avx2")))
+
+namespace MemoryNameSpace{
+
+namespace{
+
+constexpr size_t GRAIN_SIZE = 1 << 14;  ///< Elements per TBB task
+
+/**
+ * @brief Arithmetic type with wrapping overflow
+ *
+ * Integers are computed unsigned so overflow wraps instead of being undefined.
+ */
+template<typename T, bool = std::is_integral_v<T>>
+struct wrapping{ using type = T; };
+
+template<typename T>
+struct wrapping<T, true>{ using type = std::make_unsigned_t<T>; };
+
+template<typename T>
+using wrapping_t = typename wrapping<T>::type;
+
+/**
+ * @brief Type used to accumulate sums of T
+ */
+template<typename T>
+using acc_t = wrapping_t<sum_t<T>>;
+
+/**
+ * @brief Reads the element at an index from possibly unaligned storage
+ */
+template<typename T>
+KERNEL_INLINE T load(const std::byte* data, size_t index) noexcept {
+    T value;
+    std::memcpy(&value, data + index * sizeof(T), sizeof(T));
+    return value;
+}
+
+/**
+ * @brief Writes the element at an index to possibly unaligned storage
+ */
+template<typename T>
+KERNEL_INLINE void store(std::byte* data, size_t index, T value) noexcept {
+    std::memcpy(data + index * sizeof(T), &value, sizeof(T));
+}
+
+// Portable bodies. They are inlined both into the default entry points
+// and into the avx2-targeted ones, where the compiler vectorizes them
+// with 256-bit registers; the memcpy loads become unaligned moves.
+
+template<typename T>
+KERNEL_INLINE sum_t<T> sum_body(const std::byte* data, size_t size) noexcept {
+    acc_t<T> a0{}, a1{}, a2{}, a3{};
+    size_t i = 0;
+    for(; i + 4 <= size; i += 4){
+        a0 += static_cast<acc_t<T>>(load<T>(data, i));
+        a1 += static_cast<acc_t<T>>(load<T>(data, i + 1));
+        a2 += static_cast<acc_t<T>>(load<T>(data, i + 2));
+        a3 += static_cast<acc_t<T>>(load<T>(data, i + 3));
+    }
+    for(; i < size; ++i) a0 += static_cast<acc_t<T>>(load<T>(data, i));
+    return static_cast<sum_t<T>>((a0 + a1) + (a2 + a3));
+}
+
+template<typename T>
+KERNEL_INLINE std::pair<T, T> minmax_body(const std::byte* data, size_t size) noexcept {
+    T low = load<T>(data, 0), high = low;
+    for(size_t i = 1; i < size; ++i){
+        T value = load<T>(data, i);
+        low = value < low ? value : low;
+        high = value > high ? value : high;
+    }
+    return {low, high};
+}
+
+template<typename T, typename Predicate>
+KERNEL_INLINE size_t count_loop(const std::byte* data, size_t size, Predicate predicate) noexcept {
+    size_t count = 0;
+    for(size_t i = 0; i < size; ++i) count += predicate(load<T>(data, i)) ? 1 : 0;
+    return count;
+}
+
+template<typename T>
+KERNEL_INLINE size_t count_body(const std::byte* data, size_t size, Compare compare, T value) noexcept {
+    switch(compare){
+    case Compare::Equal:        return count_loop<T>(data, size, [value](T x){ return x == value; });
+    case Compare::NotEqual:     return count_loop<T>(data, size, [value](T x){ return x != value; });
+    case Compare::Less:         return count_loop<T>(data, size, [value](T x){ return x < value; });
+    case Compare::LessEqual:    return count_loop<T>(data, size, [value](T x){ return x <= value; });
+    case Compare::Greater:      return count_loop<T>(data, size, [value](T x){ return x > value; });
+    case Compare::GreaterEqual: return count_loop<T>(data, size, [value](T x){ return x >= value; });
+    }
+    return 0;
+}
+
+template<typename T>
+KERNEL_INLINE sum_t<T> dot_body(const std::byte* lhs, const std::byte* rhs, size_t size) noexcept {
+    acc_t<T> a0{}, a1{};
+    size_t i = 0;
+    for(; i + 2 <= size; i += 2){
+        a0 += static_cast<acc_t<T>>(load<T>(lhs, i)) * static_cast<acc_t<T>>(load<T>(rhs, i));
+        a1 += static_cast<acc_t<T>>(load<T>(lhs, i + 1)) * static_cast<acc_t<T>>(load<T>(rhs, i + 1));
+    }
+    for(; i < size; ++i) a0 += static_cast<acc_t<T>>(load<T>(lhs, i)) * static_cast<acc_t<T>>(load<T>(rhs, i));
+    return static_cast<sum_t<T>>(a0 + a1);
+}
+
+#ifdef MEMORY_KERNELS_X86
+
+/**
+ * @brief Checks once whether the CPU supports AVX2
+ */
+bool has_avx2() noexcept {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+template<typename T>
+KERNEL_AVX2 sum_t<T> sum_avx2(const std::byte* data, size_t size) noexcept { return sum_body<T>(data, size); }
+
+template<typename T>
+KERNEL_AVX2 std::pair<T, T> minmax_avx2(const std::byte* data, size_t size) noexcept { return minmax_body<T>(data, size); }
+
+template<typename T>
+KERNEL_AVX2 size_t count_avx2(const std::byte* data, size_t size, Compare compare, T value) noexcept { return count_body<T>(data, size, compare, value); }
+
+template<typename T>
+KERNEL_AVX2 sum_t<T> dot_avx2(const std::byte* lhs, const std::byte* rhs, size_t size) noexcept { return dot_body<T>(lhs, rhs, size); }
+
+// Floating-point reductions aren't reassociated by the compiler, and int
+// sums need widening, so these kernels are written with intrinsics. The
+// loadu forms accept any address; the scalar tails go through load.
+
+template<>
+KERNEL_AVX2 double sum_avx2<double>(const std::byte* data, size_t size) noexcept {
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for(; i + 8 <= size; i += 8){
+        a0 = _mm256_add_pd(a0, _mm256_loadu_pd(reinterpret_cast<const double*>(data + i * sizeof(double))));
+        a1 = _mm256_add_pd(a1, _mm256_loadu_pd(reinterpret_cast<const double*>(data + (i + 4) * sizeof(double))));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(a0, a1));
+    double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for(; i < size; ++i) sum += load<double>(data, i);
+    return sum;
+}
+
+template<>
+KERNEL_AVX2 long long sum_avx2<int>(const std::byte* data, size_t size) noexcept {
+    __m256i a0 = _mm256_setzero_si256(), a1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for(; i + 8 <= size; i += 8){
+        __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i * sizeof(int)));
+        a0 = _mm256_add_epi64(a0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(value)));
+        a1 = _mm256_add_epi64(a1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(value, 1)));
+    }
+    alignas(32) unsigned long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(a0, a1));
+    unsigned long long sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for(; i < size; ++i) sum += static_cast<unsigned long long>(static_cast<long long>(load<int>(data, i)));
+    return static_cast<long long>(sum);
+}
+
+template<>
+KERNEL_AVX2 std::pair<double, double> minmax_avx2<double>(const std::byte* data, size_t size) noexcept {
+    __m256d low = _mm256_set1_pd(load<double>(data, 0)), high = low;
+    size_t i = 0;
+    for(; i + 4 <= size; i += 4){
+        __m256d value = _mm256_loadu_pd(reinterpret_cast<const double*>(data + i * sizeof(double)));
+        low = _mm256_min_pd(low, value);
+        high = _mm256_max_pd(high, value);
+    }
+    alignas(32) double lows[4], highs[4];
+    _mm256_store_pd(lows, low);
+    _mm256_store_pd(highs, high);
+    std::pair<double, double> result = minmax_body<double>(reinterpret_cast<const std::byte*>(lows), 4);
+    result.second = minmax_body<double>(reinterpret_cast<const std::byte*>(highs), 4).second;
+    for(; i < size; ++i){
+        double value = load<double>(data, i);
+        result.first = value < result.first ? value : result.first;
+        result.second = value > result.second ? value : result.second;
+    }
+    return result;
+}
+
+template<>
+KERNEL_AVX2 double dot_avx2<double>(const std::byte* lhs, const std::byte* rhs, size_t size) noexcept {
+    auto at = [](const std::byte* data, size_t i){ return reinterpret_cast<const double*>(data + i * sizeof(double)); };
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for(; i + 8 <= size; i += 8){
+        a0 = _mm256_add_pd(a0, _mm256_mul_pd(_mm256_loadu_pd(at(lhs, i)), _mm256_loadu_pd(at(rhs, i))));
+        a1 = _mm256_add_pd(a1, _mm256_mul_pd(_mm256_loadu_pd(at(lhs, i + 4)), _mm256_loadu_pd(at(rhs, i + 4))));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(a0, a1));
+    double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for(; i < size; ++i) sum += load<double>(lhs, i) * load<double>(rhs, i);
+    return sum;
+}
+
+template<>
+KERNEL_AVX2 long long dot_avx2<int>(const std::byte* lhs, const std::byte* rhs, size_t size) noexcept {
+    auto at = [](const std::byte* data, size_t i){ return reinterpret_cast<const __m128i*>(data + i * sizeof(int)); };
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for(; i + 4 <= size; i += 4){
+        __m256i a = _mm256_cvtepi32_epi64(_mm_loadu_si128(at(lhs, i)));
+        __m256i b = _mm256_cvtepi32_epi64(_mm_loadu_si128(at(rhs, i)));
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(a, b));
+    }
+    alignas(32) unsigned long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    unsigned long long sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for(; i < size; ++i)
+        sum += static_cast<unsigned long long>(static_cast<long long>(load<int>(lhs, i)) * load<int>(rhs, i));
+    return static_cast<long long>(sum);
+}
+
+#endif
+
+template<typename T>
+sum_t<T> sum_chunk(const std::byte* data, size_t size) noexcept {
+#ifdef MEMORY_KERNELS_X86
+    if(has_avx2()) return sum_avx2<T>(data, size);
+#endif
+    return sum_body<T>(data, size);
+}
+
+template<typename T>
+std::pair<T, T> minmax_chunk(const std::byte* data, size_t size) noexcept {
+#ifdef MEMORY_KERNELS_X86
+    if(has_avx2()) return minmax_avx2<T>(data, size);
+#endif
+    return minmax_body<T>(data, size);
+}
+
+template<typename T>
+size_t count_chunk(const std::byte* data, size_t size, Compare compare, T value) noexcept {
+#ifdef MEMORY_KERNELS_X86
+    if(has_avx2()) return count_avx2<T>(data, size, compare, value);
+#endif
+    return count_body<T>(data, size, compare, value);
+}
+
+template<typename T>
+sum_t<T> dot_chunk(const std::byte* lhs, const std::byte* rhs, size_t size) noexcept {
+#ifdef MEMORY_KERNELS_X86
+    if(has_avx2()) return dot_avx2<T>(lhs, rhs, size);
+#endif
+    return dot_body<T>(lhs, rhs, size);
+}
+
+/**
+ * @brief Runs a chunk kernel serially or as a TBB reduction
+ *
+ * @param size Number of elements
+ * @param identity Identity of the combine operation
+ * @param chunk Kernel called as chunk(begin, count)
+ * @param combine Combines two partial results
+ */
+template<typename R, typename Chunk, typename Combine>
+R reduce_chunks(size_t size, R identity, Chunk chunk, Combine combine){
+    if(size < PARALLEL_THRESHOLD) return chunk(size_t{0}, size);
+    return tbb::parallel_reduce(tbb::blocked_range<size_t>(0, size, GRAIN_SIZE), identity,
+        [&](const tbb::blocked_range<size_t>& range, R partial){
+            return combine(partial, chunk(range.begin(), range.size()));
+        },
+        combine);
+}
+
+}
+
+template<reducible_t T>
+sum_t<T> reduce_sum(const std::byte* data, size_t count){
+    return reduce_chunks(count, sum_t<T>{},
+        [&](size_t begin, size_t size){ return sum_chunk<T>(data + begin * sizeof(T), size); },
+        [](sum_t<T> a, sum_t<T> b){ return static_cast<sum_t<T>>(static_cast<acc_t<T>>(a) + static_cast<acc_t<T>>(b)); });
+}
+
+template<reducible_t T>
+std::pair<T, T> reduce_minmax(const std::byte* data, size_t count){
+    T first = load<T>(data, 0);
+    return reduce_chunks(count, std::pair<T, T>{first, first},
+        [&](size_t begin, size_t size){ return minmax_chunk<T>(data + begin * sizeof(T), size); },
+        [](std::pair<T, T> a, std::pair<T, T> b){
+            return std::pair<T, T>{b.first < a.first ? b.first : a.first, b.second > a.second ? b.second : a.second};
+        });
+}
+
+template<reducible_t T>
+size_t reduce_count(const std::byte* data, size_t count, Compare compare, T value){
+    return reduce_chunks(count, size_t{0},
+        [&](size_t begin, size_t size){ return count_chunk<T>(data + begin * sizeof(T), size, compare, value); },
+        [](size_t a, size_t b){ return a + b; });
+}
+
+template<reducible_t T>
+sum_t<T> reduce_dot(const std::byte* lhs, const std::byte* rhs, size_t count){
+    return reduce_chunks(count, sum_t<T>{},
+        [&](size_t begin, size_t size){ return dot_chunk<T>(lhs + begin * sizeof(T), rhs + begin * sizeof(T), size); },
+        [](sum_t<T> a, sum_t<T> b){ return static_cast<sum_t<T>>(static_cast<acc_t<T>>(a) + static_cast<acc_t<T>>(b)); });
+}
+
+template<reducible_t T>
+void inclusive_prefix_sum(std::byte* data, size_t count){
+    using scan_t = wrapping_t<T>;
+    if(count < PARALLEL_THRESHOLD){
+        scan_t running{};
+        for(size_t i = 0; i < count; ++i){
+            running += static_cast<scan_t>(load<T>(data, i));
+            store<T>(data, i, static_cast<T>(running));
+        }
+        return;
+    }
+    tbb::parallel_scan(tbb::blocked_range<size_t>(0, count, GRAIN_SIZE), scan_t{},
+        [&](const tbb::blocked_range<size_t>& range, scan_t running, bool is_final){
+            for(size_t i = range.begin(); i < range.end(); ++i){
+                running += static_cast<scan_t>(load<T>(data, i));
+                if(is_final) store<T>(data, i, static_cast<T>(running));
+            }
+            return running;
+        },
+        [](scan_t a, scan_t b){ return a + b; });
+}
+
+#define INSTANTIATE_ARRAY_KERNELS(T) \
+    template sum_t<T> reduce_sum<T>(const std::byte*, size_t); \
+    template std::pair<T, T> reduce_minmax<T>(const std::byte*, size_t); \
+    template size_t reduce_count<T>(const std::byte*, size_t, Compare, T); \
+    template sum_t<T> reduce_dot<T>(const std::byte*, const std::byte*, size_t); \
+    template void inclusive_prefix_sum<T>(std::byte*, size_t);
+
+INSTANTIATE_ARRAY_KERNELS(int)
+INSTANTIATE_ARRAY_KERNELS(long long)
+INSTANTIATE_ARRAY_KERNELS(size_t)
+INSTANTIATE_ARRAY_KERNELS(double)
+
+#undef INSTANTIATE_ARRAY_KERNELS
+
+}
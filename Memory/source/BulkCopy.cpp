@@ -0,0 +1,92 @@
+#include <Memory/BulkCopy.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace MemoryNameSpace{
+
+namespace{
+
+#if defined(__SSE2__)
+/**
+ * @brief Number of bytes before the next 16-byte boundary
+ */
+size_t misalignment(const std::byte* pointer) noexcept {
+    return (16 - (reinterpret_cast<uintptr_t>(pointer) & 15)) & 15;
+}
+
+/**
+ * @brief Streams whole 16-byte blocks from an unaligned source to an aligned destination
+ *
+ * @return size_t Number of bytes written
+ */
+size_t stream_copy(std::byte* destination, const std::byte* source, size_t size) noexcept {
+    size_t done = 0;
+    for(; done + 64 <= size; done += 64){
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + done));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + done + 16));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + done + 32));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + done + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(destination + done), a);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(destination + done + 16), b);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(destination + done + 32), c);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(destination + done + 48), d);
+    }
+    for(; done + 16 <= size; done += 16)
+        _mm_stream_si128(reinterpret_cast<__m128i*>(destination + done),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + done)));
+    _mm_sfence();
+    return done;
+}
+#endif
+
+}
+
+void copy_bytes(std::byte* destination, const std::byte* source, size_t size) noexcept {
+#if defined(__SSE2__)
+    if(size >= NON_TEMPORAL_THRESHOLD){
+        size_t head = misalignment(destination);
+        std::memcpy(destination, source, head);
+        size_t done = head + stream_copy(destination + head, source + head, size - head);
+        std::memcpy(destination + done, source + done, size - done);
+        return;
+    }
+#endif
+    if(size != 0) std::memcpy(destination, source, size);
+}
+
+void fill_bytes(std::byte* destination, size_t count, const std::byte* pattern, size_t pattern_size) noexcept {
+    size_t size = count * pattern_size;
+    if(size == 0) return;
+#if defined(__SSE2__)
+    if(size >= NON_TEMPORAL_THRESHOLD && 16 % pattern_size == 0){
+        // The pattern is rotated so the streamed blocks start at an aligned address.
+        size_t head = misalignment(destination);
+        alignas(16) std::byte block[16];
+        for(size_t i = 0; i < 16; ++i)
+            block[i] = pattern[(head + i) % pattern_size];
+        for(size_t i = 0; i < head; ++i)
+            destination[i] = pattern[i % pattern_size];
+        __m128i value = _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+        size_t done = head;
+        for(; done + 16 <= size; done += 16)
+            _mm_stream_si128(reinterpret_cast<__m128i*>(destination + done), value);
+        _mm_sfence();
+        for(; done < size; ++done)
+            destination[done] = pattern[done % pattern_size];
+        return;
+    }
+#endif
+    std::memcpy(destination, pattern, pattern_size);
+    size_t filled = pattern_size;
+    while(filled < size){
+        size_t chunk = std::min(filled, size - filled);
+        std::memcpy(destination + filled, destination, chunk);
+        filled += chunk;
+    }
+}
+
+}
@@ -0,0 +1,59 @@
+#include <Memory/DescriptorPool.hpp>
+
+namespace MemoryNameSpace{
+
+namespace{
+
+constexpr size_t header_size = (sizeof(void*) * 3 + DescriptorPool::GRANULARITY - 1) / DescriptorPool::GRANULARITY * DescriptorPool::GRANULARITY;
+
+}
+
+DescriptorPool::~DescriptorPool(){
+    while(slabs_ != nullptr){
+        SlabHeader* next = slabs_->next;
+        ::operator delete(slabs_, std::align_val_t{SLAB_SIZE});
+        slabs_ = next;
+    }
+}
+
+void* DescriptorPool::allocate(size_t size_class){
+    SizeClass& cls = classes_[size_class];
+    ++live_objects_;
+    if(cls.free != nullptr){
+        FreeChunk* chunk = cls.free;
+        cls.free = chunk->next;
+        return chunk;
+    }
+    const size_t chunk_size = (size_class + 1) * GRANULARITY;
+    if(cls.bump == nullptr || static_cast<size_t>(cls.bump_end - cls.bump) < chunk_size){
+        std::byte* memory = nullptr;
+        try{ memory = static_cast<std::byte*>(::operator new(SLAB_SIZE, std::align_val_t{SLAB_SIZE})); }
+        catch(...){
+            --live_objects_;
+            throw;
+        }
+        slabs_ = ::new(memory) SlabHeader{this, size_class, slabs_};
+        ++slab_count_;
+        cls.bump = memory + header_size;
+        cls.bump_end = memory + SLAB_SIZE;
+    }
+    void* chunk = cls.bump;
+    cls.bump += chunk_size;
+    return chunk;
+}
+
+void DescriptorPool::release(void* chunk, size_t size_class) noexcept {
+    SizeClass& cls = classes_[size_class];
+    cls.free = ::new(chunk) FreeChunk{cls.free};
+    --live_objects_;
+}
+
+size_t DescriptorPool::get_live_objects() const noexcept {
+    return live_objects_;
+}
+
+size_t DescriptorPool::get_reserved_bytes() const noexcept {
+    return slab_count_ * SLAB_SIZE;
+}
+
+}
@@ -0,0 +1,69 @@
+#include <Memory/ElementTable.hpp>
+#include <algorithm>
+#include <numeric>
+
+namespace MemoryNameSpace{
+
+ElementId ElementTable::insert(IMemoryElement* element, ElementKind kind, size_t offset, size_t size, size_t elem_size){
+    if(!free_ids_.empty()){
+        ElementId id = free_ids_.back();
+        free_ids_.pop_back();
+        offsets_[id] = offset;
+        sizes_[id] = size;
+        elem_sizes_[id] = elem_size;
+        kinds_[id] = kind;
+        owners_[id] = INVALID_PROGRAM_ID;
+        elements_[id] = element;
+        pins_[id] = 0;
+        return id;
+    }
+    if(free_ids_.capacity() <= offsets_.size()){
+        // Grow all columns together so the push_backs below can't throw, and
+        // keep room for every id in the free list so erase() never allocates.
+        // The free list is grown last, so a failed reserve is retried next time.
+        size_t capacity = std::max<size_t>(16, 2 * free_ids_.capacity());
+        offsets_.reserve(capacity);
+        sizes_.reserve(capacity);
+        elem_sizes_.reserve(capacity);
+        kinds_.reserve(capacity);
+        owners_.reserve(capacity);
+        elements_.reserve(capacity);
+        pins_.reserve(capacity);
+        free_ids_.reserve(capacity);
+    }
+    ElementId id = static_cast<ElementId>(offsets_.size());
+    offsets_.push_back(offset);
+    sizes_.push_back(size);
+    elem_sizes_.push_back(elem_size);
+    kinds_.push_back(kind);
+    owners_.push_back(INVALID_PROGRAM_ID);
+    elements_.push_back(element);
+    pins_.push_back(0);
+    return id;
+}
+
+void ElementTable::erase(ElementId id) noexcept {
+    sizes_[id] = 0;
+    elem_sizes_[id] = 0;
+    owners_[id] = INVALID_PROGRAM_ID;
+    elements_[id] = nullptr;
+    free_ids_.push_back(id);
+}
+
+size_t ElementTable::get_used_memory() const noexcept {
+    return std::reduce(sizes_.begin(), sizes_.end(), size_t{0});
+}
+
+std::vector<ElementId> ElementTable::ids_by_offset() const {
+    std::vector<ElementId> ids;
+    ids.reserve(size());
+    for(size_t id = 0; id < elements_.size(); ++id)
+        if(elements_[id] != nullptr)
+            ids.push_back(static_cast<ElementId>(id));
+    std::sort(ids.begin(), ids.end(), [this](ElementId a, ElementId b){
+        return offsets_[a] < offsets_[b];
+    });
+    return ids;
+}
+
+}
@@ -0,0 +1,255 @@
+#include <Memory/ErrorLog.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace MemoryNameSpace{
+
+namespace{
+
+/**
+ * @brief Gets the text of an interned name, or an empty string
+ */
+std::string_view text(const InternedName* name) noexcept {
+    return name != nullptr ? std::string_view{name->name} : std::string_view{};
+}
+
+/**
+ * @brief Cuts a text to the length stored in the log
+ */
+std::string_view clip(std::string_view text) noexcept {
+    return text.substr(0, ErrorLog::MAX_TEXT_LENGTH);
+}
+
+}
+
+ErrorLog::ErrorLog(size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {}
+
+error_t ErrorLog::type_of(ErrorCode code) noexcept {
+    switch(code){
+    case ErrorCode::BufferOverflow:
+    case ErrorCode::InvalidBlock:
+    case ErrorCode::MemoryLimitExceeded:
+    case ErrorCode::RangeOutOfBounds:
+    case ErrorCode::ByteRangeOutOfBounds:
+    case ErrorCode::LengthMismatch:
+    case ErrorCode::Custom:
+        return SIZE_ERROR;
+    case ErrorCode::AlreadyAllocated:
+    case ErrorCode::AlreadyFreed:
+    case ErrorCode::ElementStillReachable:
+    case ErrorCode::SegmentInUse:
+    case ErrorCode::LastSegmentOwner:
+        return MEMORY_LEAK;
+    case ErrorCode::DoubleFree:
+        return DOUBLE_FREE;
+    case ErrorCode::ProgramNotFound:
+    case ErrorCode::ProgramExists:
+    case ErrorCode::ElementNotFound:
+    case ErrorCode::ElementNotAvailable:
+    case ErrorCode::ElementPinned:
+    case ErrorCode::NotSharedSegment:
+    case ErrorCode::ReferenceToReference:
+    case ErrorCode::SegmentAccessDenied:
+    case ErrorCode::DefragmentationPinned:
+        return ACCESS_ERROR;
+    }
+    return SIZE_ERROR;
+}
+
+std::string ErrorLog::format(const ErrorRecord& record){
+    std::string subject{text(record.subject)};
+    const ErrorArgs& args = record.args;
+    switch(record.code){
+    case ErrorCode::Custom: return subject;
+    case ErrorCode::BufferOverflow: return "Buffer overflow.";
+    case ErrorCode::InvalidBlock: return "Invalid offset " + std::to_string(args[0]) + " with size " + std::to_string(args[1]) + ".";
+    case ErrorCode::DoubleFree: return "Double free.";
+    case ErrorCode::AlreadyAllocated: return "Invalid write. The memory for variable '" + subject + "' has already been allocated.";
+    case ErrorCode::AlreadyFreed: return "Invalid free. The memory for variable '" + subject + "' has already been free.";
+    case ErrorCode::ProgramNotFound: return "The program does not exist.";
+    case ErrorCode::ProgramExists: return "The program has already been created.";
+    case ErrorCode::ElementNotFound: return "The variable '" + subject + "' does not exist.";
+    case ErrorCode::ElementNotAvailable: return "The variable '" + subject + "' is not available for program.";
+    case ErrorCode::ElementPinned: return "The variable '" + subject + "' is pinned by a view.";
+    case ErrorCode::ElementStillReachable: return "The element '" + subject + "' is still reachable.";
+    case ErrorCode::NotSharedSegment: return "The variable '" + subject + "' is not shared segment.";
+    case ErrorCode::ReferenceToReference: return "You can't create a link to a link.";
+    case ErrorCode::MemoryLimitExceeded: return "The memory limit in the '" + subject + "' program has been exceeded.";
+    case ErrorCode::SegmentAccessDenied: return "The program doesn't have access to the segment '" + subject + "'.";
+    case ErrorCode::SegmentInUse: return "The segment '" + subject + "' is still used by other programs.";
+    case ErrorCode::LastSegmentOwner: return "This is the last program that owns the segment '" + subject + "'.";
+    case ErrorCode::DefragmentationPinned: return "Defragmentation is blocked by " + std::to_string(args[0]) + " pinned views.";
+    case ErrorCode::RangeOutOfBounds:
+        return "The range [" + std::to_string(args[0]) + ", " + std::to_string(args[1]) + ") is out of bounds of the array '" +
+               subject + "' with " + std::to_string(args[2]) + " elements.";
+    case ErrorCode::ByteRangeOutOfBounds:
+        return "The byte range [" + std::to_string(args[0]) + ", " + std::to_string(args[1]) + ") is out of bounds of the variable '" +
+               subject + "' with " + std::to_string(args[2]) + " bytes.";
+    case ErrorCode::LengthMismatch:
+        return "The arrays '" + subject + "' and '" + std::string(text(record.other)) + "' have different lengths.";
+    }
+    return subject;
+}
+
+ErrorLog::ProgramChain& ErrorLog::chain_of(std::string_view program){
+    if(const InternedName* name = names_.find(program); name != nullptr){
+        auto it = by_program_.find(name);
+        if(it != by_program_.end()) return it->second;
+    }
+    // The chain holds its own reference to the program name.
+    const InternedName& name = names_.intern(program);
+    try{
+        return by_program_[&name];
+    }
+    catch(...){
+        names_.release(name);
+        throw;
+    }
+}
+
+void ErrorLog::drop_if_unused(std::unordered_map<const InternedName*, ProgramChain>::iterator chain) noexcept {
+    if(chain->second.live != 0 || chain->second.has_limit) return;
+    const InternedName* name = chain->first;
+    by_program_.erase(chain);
+    names_.release(*name);
+}
+
+void ErrorLog::evict_oldest(const ProgramChain& current) noexcept {
+    const ErrorRecord& oldest = at(next_ - capacity_);
+    auto program = by_program_.find(oldest.program);
+    program->second.head = oldest.next_of_program;
+    --program->second.live;
+    Chain& type = by_type_[oldest.type];
+    type.head = oldest.next_of_type;
+    --type.live;
+    for(const InternedName* name : {oldest.program, oldest.subject, oldest.other})
+        if(name != nullptr) names_.release(*name);
+    if(&program->second != &current) drop_if_unused(program);
+}
+
+bool ErrorLog::coalesce(const ProgramChain& chain, ErrorCode code, error_t type, const ErrorContext& context,
+                        std::chrono::steady_clock::time_point now) noexcept {
+    if(chain.live == 0) return false;
+    ErrorRecord& last = ring_[chain.tail % capacity_];
+    if(last.code != code || last.type != type || last.args != context.args ||
+       text(last.subject) != context.subject || text(last.other) != context.other)
+        return false;
+    ++last.count;
+    last.last = now;
+    return true;
+}
+
+bool ErrorLog::admit(ProgramChain& chain, std::chrono::steady_clock::time_point now) noexcept {
+    const ErrorRateLimit& limit = chain.has_limit ? chain.limit : default_limit_;
+    if(limit.records == 0) return true;
+    if(now - chain.window_start >= limit.window){
+        chain.window_start = now;
+        chain.window_records = 0;
+    }
+    if(chain.window_records == limit.records){
+        ++chain.suppressed;
+        ++suppressed_;
+        return false;
+    }
+    ++chain.window_records;
+    return true;
+}
+
+void ErrorLog::link(Chain& chain, uint64_t sequence, uint64_t ErrorRecord::* next) noexcept {
+    if(chain.live == 0) chain.head = sequence;
+    else ring_[chain.tail % capacity_].*next = sequence;
+    chain.tail = sequence;
+    ++chain.live;
+}
+
+void ErrorLog::push(ErrorCode code, error_t type, std::string_view program, const ErrorContext& raw_context){
+    auto now = std::chrono::steady_clock::now();
+    program = clip(program);
+    ErrorContext context{clip(raw_context.subject), clip(raw_context.other), raw_context.args};
+    ProgramChain& chain = chain_of(program);
+    ++chain.total;
+    ++by_type_[type].total;
+    if(coalesce(chain, code, type, context, now) || !admit(chain, now)) return;
+
+    ErrorRecord record;
+    record.first = now;
+    record.last = now;
+    record.args = context.args;
+    record.program = &names_.intern(program);
+    if(!context.subject.empty()) record.subject = &names_.intern(context.subject);
+    if(!context.other.empty()) record.other = &names_.intern(context.other);
+    record.code = code;
+    record.type = type;
+
+    uint64_t sequence = next_;
+    if(ring_.size() < capacity_) ring_.push_back(record);
+    else{
+        evict_oldest(chain);
+        ring_[sequence % capacity_] = record;
+    }
+    ++next_;
+    link(chain, sequence, &ErrorRecord::next_of_program);
+    link(by_type_[type], sequence, &ErrorRecord::next_of_type);
+}
+
+void ErrorLog::record(ErrorCode code, std::string_view program, const ErrorContext& context){
+    push(code, type_of(code), program, context);
+}
+
+void ErrorLog::record_text(error_t type, std::string_view description, std::string_view program){
+    if(!is_error_type(type))
+        throw std::out_of_range("Invalid error type " + std::to_string(static_cast<size_t>(type)) + ".");
+    push(ErrorCode::Custom, type, program, ErrorContext{description, {}, {}});
+}
+
+std::vector<Error> ErrorLog::collect(const Chain& chain, uint64_t ErrorRecord::* next) const {
+    std::vector<Error> errors;
+    errors.reserve(chain.live);
+    uint64_t sequence = chain.head;
+    for(size_t i = 0; i < chain.live; ++i){
+        const ErrorRecord& record = at(sequence);
+        errors.emplace_back(record.type, format(record), std::string(text(record.program)), record.first, record.last, record.count);
+        sequence = record.*next;
+    }
+    return errors;
+}
+
+std::vector<Error> ErrorLog::all() const {
+    std::vector<Error> errors;
+    errors.reserve(ring_.size());
+    for(uint64_t sequence = next_ - ring_.size(); sequence < next_; ++sequence){
+        const ErrorRecord& record = at(sequence);
+        errors.emplace_back(record.type, format(record), std::string(text(record.program)), record.first, record.last, record.count);
+    }
+    return errors;
+}
+
+std::vector<Error> ErrorLog::by_program(std::string_view program) const {
+    auto it = by_program_.find(names_.find(clip(program)));
+    if(it == by_program_.end()) return {};
+    return collect(it->second, &ErrorRecord::next_of_program);
+}
+
+std::vector<Error> ErrorLog::by_type(error_t type) const {
+    if(!is_error_type(type)) return {};
+    return collect(by_type_[type], &ErrorRecord::next_of_type);
+}
+
+size_t ErrorLog::count(std::string_view program) const {
+    auto it = by_program_.find(names_.find(clip(program)));
+    return it != by_program_.end() ? it->second.live : 0;
+}
+
+void ErrorLog::set_rate_limit(std::string_view program, ErrorRateLimit limit){
+    ProgramChain& chain = chain_of(clip(program));
+    chain.limit = limit;
+    chain.has_limit = true;
+    chain.window_records = 0;
+}
+
+size_t ErrorLog::suppressed(std::string_view program) const {
+    auto it = by_program_.find(names_.find(clip(program)));
+    return it != by_program_.end() ? it->second.suppressed : 0;
+}
+
+}
@@ -1,30 +1,60 @@
 #include <Memory/MemoryElement.hpp>
 #include <Memory/Program.hpp>
+#include <stdexcept>
 
 namespace MemoryNameSpace{
 
-MemoryElement::~MemoryElement() {}
+MemoryElement::~MemoryElement() {
+    table_.erase(id_);
+    manager_.release_name(*name_);
+}
+
+const std::string& MemoryElement::get_name() const noexcept { return name_->name; }
 
-const std::string& MemoryElement::get_name() const noexcept { return name_; }
+std::string_view MemoryElement::get_owner_name() const noexcept {
+    const Program* owner = manager_.find_program(table_.get_owner(id_));
+    return owner != nullptr ? std::string_view{owner->get_name()} : std::string_view{};
+}
 
-size_t MemoryElement::get_size() const noexcept { return size_; }
+size_t MemoryElement::get_name_hash() const noexcept { return name_->hash; }
 
-size_t MemoryElement::get_elem_size() const noexcept { return size_; }
+size_t MemoryElement::get_size() const noexcept { return table_.get_size(id_); }
 
-size_t MemoryElement::get_offset() const noexcept { return offset_; }
+size_t MemoryElement::get_elem_size() const noexcept { return table_.get_elem_size(id_); }
+
+size_t MemoryElement::get_offset() const noexcept { return table_.get_offset(id_); }
 
 void MemoryElement::set_offset(size_t offset) noexcept {
-    offset_ = offset;
+    table_.set_offset(id_, offset);
+}
+
+std::byte* MemoryElement::raw_data() const {
+    std::byte* data = manager_.get_data();
+    if(data == nullptr)
+        throw std::runtime_error("The buffer of memory element '" + get_name() + "' has no storage.");
+    return data + table_.get_offset(id_);
 }
 
-void MemoryElement::get_raw_value(std::byte* value, size_t, size_t) const {
-    std::byte* target = manager_.get_data() + offset_;
-    std::copy(target, target + size_, value);
+void MemoryElement::get_raw_value(std::byte* value, size_t begin, size_t end) const {
+    std::byte* target = raw_data();
+    if(end == 0){
+        std::copy(target, target + table_.get_size(id_), value);
+        return;
+    }
+    if(begin > end || end > table_.get_size(id_))
+        throw std::runtime_error("Invalid byte range in MemoryElement::get_raw_value.");
+    std::copy(target + begin, target + end, value);
 }
 
-void MemoryElement::set_raw_value(const std::byte* value, size_t, size_t){
-    std::byte* target = manager_.get_data() + offset_;
-    std::copy(value, value + size_, target);
+void MemoryElement::set_raw_value(const std::byte* value, size_t begin, size_t end){
+    std::byte* target = raw_data();
+    if(end == 0){
+        std::copy(value, value + table_.get_size(id_), target);
+        return;
+    }
+    if(begin > end || end > table_.get_size(id_))
+        throw std::runtime_error("Invalid byte range in MemoryElement::set_raw_value.");
+    std::copy(value, value + (end - begin), target + begin);
 }
 
 bool MemoryElement::is_possible_to_destroy(__attribute__((unused)) const std::string& prog) const {
@@ -33,19 +63,15 @@ bool MemoryElement::is_possible_to_destroy(__attribute__((unused)) const std::st
 
 bool MemoryElement::destroy(Program& prog){
     prog.erase_element(this);
-    if(manager_.destroy_element(name_, prog) == false){
+    if(manager_.destroy_element(name_->name, prog) == false){
         prog.insert_element(this);
         return false;
     }
     return true;
 }
 
-bool MemoryElement::is_reference() const noexcept {
-    return false;
-}
-
 ReferenceDescriptor MemoryElement::make_reference(std::string name) {
-    return ReferenceDescriptor{name, name_, manager_};
+    return ReferenceDescriptor{name, name_->name, this, manager_};
 }
 
 }
@@ -0,0 +1,48 @@
+#include <Memory/NameArena.hpp>
+
+namespace MemoryNameSpace{
+
+const InternedName& NameArena::intern(std::string_view name){
+    size_t hash = hash_name(name);
+    auto it = index_.find(HashedName{name, hash});
+    if(it != index_.end()){
+        ++it->second->references;
+        return *it->second;
+    }
+    InternedName* stored;
+    if(!free_.empty()){
+        stored = free_.back();
+        stored->name.assign(name);
+        stored->hash = hash;
+        free_.pop_back();
+    }
+    else{
+        stored = &names_.emplace_back(InternedName{std::string(name), hash});
+        // Every slot fits in the free list, so release never allocates.
+        free_.reserve(names_.size());
+    }
+    index_.try_emplace_hashed(hash, std::string_view{stored->name}, stored);
+    stored->references = 1;
+    return *stored;
+}
+
+void NameArena::release(const InternedName& name) noexcept {
+    auto it = index_.find(HashedName{name.name, name.hash});
+    if(it == index_.end() || --it->second->references != 0) return;
+    InternedName* stored = it->second;
+    index_.erase(it);
+    // The slot keeps its capacity, so recreating a long name doesn't allocate.
+    stored->name.clear();
+    free_.push_back(stored);
+}
+
+const InternedName* NameArena::find(std::string_view name) const {
+    auto it = index_.find(name);
+    return it != index_.end() ? it->second : nullptr;
+}
+
+size_t NameArena::size() const noexcept {
+    return names_.size() - free_.size();
+}
+
+}
@@ -1,14 +1,19 @@
 #include <Memory/Program.hpp>
 #include <Memory/Manager.hpp>
-#include <iostream>
+#include <Memory/ElementVisitor.hpp>
+#include <Memory/Trace.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <execution>
+#include <limits>
 #include <numeric>
+#include <random>
 #include <ranges>
 #include <thread>
-#include <future>
 #include <tbb/parallel_reduce.h>
 #include <tbb/blocked_range.h>
-#include <tbb/concurrent_vector.h>
+#include <tbb/task_arena.h>
 
 namespace MemoryNameSpace{
 
@@ -16,23 +21,59 @@ const std::string& Program::get_name() const {
     return name_;
 }
 
+size_t Program::get_name_hash() const noexcept {
+    return name_hash_;
+}
+
+ProgramId Program::get_id() const noexcept {
+    return id_;
+}
+
 void Program::insert_element(IMemoryElement* element){
-    memory_elements_.try_emplace(element->get_name(), element);
+    memory_elements_.try_emplace_hashed(element->get_name_hash(), element->get_name(), element);
 }
 
 void Program::erase_element(IMemoryElement* element){
-    memory_elements_.erase(element->get_name());
+    auto it = memory_elements_.find(HashedName{element->get_name(), element->get_name_hash()});
+    if(it != memory_elements_.end()) memory_elements_.erase(it);
+}
+
+void Program::adopt_element(PooledPtr<IMemoryElement> element){
+    size_t hash = element->get_name_hash();
+    std::string_view name = element->get_name();
+    owned_elements_.try_emplace_hashed(hash, name, std::move(element));
+}
+
+PooledPtr<IMemoryElement> Program::disown_element(const IMemoryElement& element) noexcept {
+    auto it = owned_elements_.find(HashedName{element.get_name(), element.get_name_hash()});
+    if(it == owned_elements_.end() || it->second.get() != &element) return nullptr;
+    PooledPtr<IMemoryElement> owned = std::move(it->second);
+    owned_elements_.erase(it);
+    return owned;
+}
+
+NameMap<PooledPtr<IMemoryElement>> Program::disown_elements() noexcept {
+    return std::move(owned_elements_);
+}
+
+IMemoryElement* Program::find_owned_element(std::string_view name) const {
+    auto it = owned_elements_.find(name);
+    return it != owned_elements_.end() ? it->second.get() : nullptr;
+}
+
+const NameMap<PooledPtr<IMemoryElement>>& Program::get_owned_elements() const noexcept {
+    return owned_elements_;
 }
 
 ReferenceDescriptor* Program::make_reference(const std::string& name, const std::string& target_name){
     auto it = memory_elements_.find(target_name);
     if(it == memory_elements_.end()){
-        record_error(ACCESS_ERROR, "The variable named '" + target_name + "' is not available for program.");
+        manager_.record_error(ErrorCode::ElementNotAvailable, name_, {target_name});
         return nullptr;
     }
     ReferenceDescriptor* reference = manager_.make_reference(name, target_name, *this);
     if(reference == nullptr) return nullptr;
-    memory_elements_.insert({name, reference});
+    memory_elements_.try_emplace_hashed(reference->get_name_hash(), reference->get_name(), reference);
     return reference;
 }
 
@@ -40,90 +81,213 @@ void Program::record_error(size_t type, const std::string& description){
     manager_.record_error(type, description, name_);
 }
 
-bool Program::destroy_element(const std::string& name){
+bool Program::destroy_element(std::string_view name){
     auto it = memory_elements_.find(name);
     if(it == memory_elements_.end()){
-        record_error(ACCESS_ERROR, "The variable '" + name + "' is not available for program.");
+        manager_.record_error(ErrorCode::ElementNotAvailable, name_, {name});
         return false;
     }
     if(!it->second->is_possible_to_destroy(name_)) return false;
-    return it->second->destroy(*this);
+    ElementId id = it->second->get_id();
+    if(!it->second->destroy(*this)) return false;
+    if(TraceRecorder* recorder = manager_.get_trace_recorder()) recorder->record_free(id_, id);
+    return true;
+}
+
+void Program::trace_allocation(const IMemoryElement& element) const {
+    if(TraceRecorder* recorder = manager_.get_trace_recorder()) recorder->record_allocate(id_, element);
 }
 
 bool Program::possible_for_expansion(size_t size) const {
-    if(size > memory_limit_ - get_used_memory())
+    // The manager keeps the usage of every program, so no scan is needed here.
+    if(size > memory_limit_ - manager_.get_stats().usage(id_))
         return false;
     return true;
 }
 
-// 1 thread
+namespace{
 
-size_t Program::get_used_memory() const noexcept {
-    return std::transform_reduce(memory_elements_.begin(), memory_elements_.end(), size_t{0}, std::plus<>{},
-        [](const auto& pair) -> size_t {
-            return pair.second->is_reference() ? 0 : pair.second->get_size();
-        }
-    );
+std::atomic<size_t> parallel_threshold{USED_MEMORY_PARALLEL_THRESHOLD};  ///< Threshold of UsedMemoryStrategy::Auto
+constexpr size_t GRAIN_SIZE = 1 << 12;  ///< Slots per TBB task
+
+/**
+ * @brief Sums the sizes of the elements in slots [begin, end) of a table
+ *
+ * @param size Gets the size of a stored element
+ */
+template<typename Table, typename Size>
+size_t sum_slots(const Table& table, size_t begin, size_t end, Size size) noexcept {
+    size_t sum = 0;
+    for(size_t index = begin; index < end; ++index)
+        if(auto* slot = table.slot(index)) sum += size(slot->second);
+    return sum;
 }
 
-// vector from views
-/*
-size_t Program::get_used_memory() const noexcept {
-    auto range = memory_elements_ | std::views::values;
-    std::vector<IMemoryElement*> vec(range.begin(), range.end());
-    return std::transform_reduce(std::execution::par, vec.begin(), vec.end(), size_t{0}, std::plus<>{},
-        [](const auto& ptr) -> size_t {
-            return ptr->is_reference() ? 0 : ptr->get_size();
-        }
-    );
-}*/
-
-// manual multithreading
-/*
-size_t Program::get_used_memory() const noexcept {
-    using It = decltype(memory_elements_.cbegin());
-    size_t threadNum = std::thread::hardware_concurrency();
-    if (threadNum == 0) threadNum = 64;
-    size_t elements = memory_elements_.size();
-    if (elements == 0) return 0;
-
-    std::vector<size_t> results(threadNum, 0);
-    std::vector<std::thread> threads(threadNum);
-
-    It first = memory_elements_.cbegin();
-    for (size_t i = 0; i < threadNum; ++i) {
-        size_t start_i = i * elements / threadNum;
-        size_t end_i = (i + 1) * elements / threadNum;
-        It start = std::next(first, start_i);
-        It end   = std::next(first, end_i);
-        threads[i] = std::thread([start, end, &results, i]() {
-            size_t local = 0;
-            for (auto it = start; it != end; ++it) {
-                const auto* ptr = it->second;
-                if (!ptr->is_reference())
-                    local += ptr->get_size();
-            }
-            results[i] = local;
+/**
+ * @brief Sums the sizes of all elements on the calling thread
+ */
+template<typename Table, typename Size>
+size_t sum_serial(const Table& table, Size size){
+    return std::transform_reduce(table.begin(), table.end(), size_t{0}, std::plus<>{},
+        [&](const auto& pair) -> size_t { return size(pair.second); });
+}
+
+/**
+ * @brief Sums the sizes of all elements with the parallel STL over slot indices
+ */
+template<typename Table, typename Size>
+size_t sum_parallel_stl(const Table& table, Size size){
+    auto slots = std::views::iota(size_t{0}, table.capacity());
+    return std::transform_reduce(std::execution::par, slots.begin(), slots.end(), size_t{0}, std::plus<>{},
+        [&](size_t index) -> size_t {
+            auto* slot = table.slot(index);
+            return slot != nullptr ? size(slot->second) : 0;
         });
-    }
+}
 
-    for (auto& th : threads)
-        th.join();
+/**
+ * @brief Sums the sizes of all elements with one std::thread per slot subrange
+ */
+template<typename Table, typename Size>
+size_t sum_threads(const Table& table, Size size){
+    size_t slots = table.capacity();
+    size_t thread_count = std::thread::hardware_concurrency();
+    if(thread_count == 0) thread_count = 64;
+    thread_count = std::min(thread_count, std::max<size_t>(slots / GRAIN_SIZE, 1));
+
+    std::vector<size_t> results(thread_count, 0);
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for(size_t i = 0; i < thread_count; ++i){
+        threads.emplace_back([&table, &results, size, i, slots, thread_count](){
+            results[i] = sum_slots(table, i * slots / thread_count, (i + 1) * slots / thread_count, size);
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
     return std::accumulate(results.begin(), results.end(), size_t{0});
-}*/
+}
 
-const std::unordered_map<std::string, IMemoryElement*>& Program::get_memory_elements() const noexcept {
+/**
+ * @brief Sums the sizes of all elements with a TBB reduction over slot subranges
+ */
+template<typename Table, typename Size>
+size_t sum_tbb(const Table& table, Size size){
+    return tbb::parallel_reduce(tbb::blocked_range<size_t>(0, table.capacity(), GRAIN_SIZE), size_t{0},
+        [&](const tbb::blocked_range<size_t>& range, size_t partial){
+            return partial + sum_slots(table, range.begin(), range.end(), size);
+        },
+        std::plus<>{});
+}
+
+/**
+ * @brief Gets the memory of an element; references have none
+ */
+size_t element_memory(const IMemoryElement* element) noexcept {
+    return element->is_reference() ? 0 : element->get_size();
+}
+
+/**
+ * @brief Gets the fastest of several runs of a function in nanoseconds
+ */
+template<typename F>
+long long fastest_run(F&& function){
+    long long best = std::numeric_limits<long long>::max();
+    for(int run = 0; run < 5; ++run){
+        auto start = std::chrono::steady_clock::now();
+        volatile size_t sum = function();
+        (void)sum;
+        auto end = std::chrono::steady_clock::now();
+        best = std::min<long long>(best, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+    return best;
+}
+
+}
+
+size_t Program::get_used_memory() const {
+    return get_used_memory(UsedMemoryStrategy::Auto);
+}
+
+size_t Program::get_used_memory(UsedMemoryStrategy strategy) const {
+    if(strategy == UsedMemoryStrategy::Auto)
+        strategy = memory_elements_.size() < get_parallel_threshold() ? UsedMemoryStrategy::Serial : UsedMemoryStrategy::Tbb;
+    switch(strategy){
+    case UsedMemoryStrategy::ParallelStl: return sum_parallel_stl(memory_elements_, element_memory);
+    case UsedMemoryStrategy::Threads: return sum_threads(memory_elements_, element_memory);
+    case UsedMemoryStrategy::Tbb: return sum_tbb(memory_elements_, element_memory);
+    case UsedMemoryStrategy::Auto:
+    case UsedMemoryStrategy::Serial: break;
+    }
+    return sum_serial(memory_elements_, element_memory);
+}
+
+size_t Program::get_parallel_threshold() noexcept {
+    return parallel_threshold.load(std::memory_order_relaxed);
+}
+
+void Program::set_parallel_threshold(size_t threshold) noexcept {
+    parallel_threshold.store(threshold, std::memory_order_relaxed);
+}
+
+size_t Program::calibrate_parallel_threshold(){
+    // Sizes are read through pointers into a shuffled array, like the
+    // descriptor pointers of a real namespace.
+    constexpr size_t MIN_ELEMENTS = 1 << 8;
+    constexpr size_t MAX_ELEMENTS = 1 << 20;
+    std::vector<size_t> sizes(MAX_ELEMENTS);
+    std::iota(sizes.begin(), sizes.end(), size_t{1});
+    std::shuffle(sizes.begin(), sizes.end(), std::mt19937_64{MAX_ELEMENTS});
+    auto size = [](const size_t* value) noexcept { return *value; };
+
+    size_t threshold = std::numeric_limits<size_t>::max();
+    if(tbb::this_task_arena::max_concurrency() <= 1){
+        set_parallel_threshold(threshold);
+        return threshold;
+    }
+    // The parallel sum must be at least a fifth faster on two sizes in a row.
+    constexpr long long MARGIN_PERCENT = 80;
+    constexpr int REQUIRED_WINS = 2;
+    FlatTable<size_t, const size_t*> table;
+    size_t first_win = 0;
+    int wins = 0;
+    for(size_t count = MIN_ELEMENTS; count <= MAX_ELEMENTS; count *= 2){
+        table.reserve(count);
+        for(size_t i = table.size(); i < count; ++i) table.try_emplace(i, &sizes[i]);
+        long long serial = fastest_run([&]{ return sum_serial(table, size); });
+        long long parallel = fastest_run([&]{ return sum_tbb(table, size); });
+        if(parallel * 100 > serial * MARGIN_PERCENT){
+            wins = 0;
+            continue;
+        }
+        if(wins++ == 0) first_win = count;
+        if(wins == REQUIRED_WINS){
+            threshold = first_win;
+            break;
+        }
+    }
+    set_parallel_threshold(threshold);
+    return threshold;
+}
+
+const NameMap<IMemoryElement*>& Program::get_memory_elements() const noexcept {
     return memory_elements_;
 }
 
-Program::~Program(){
+IMemoryElement* Program::find_element(std::string_view name) const {
+    auto it = memory_elements_.find(name);
+    return it != memory_elements_.end() ? it->second : nullptr;
+}
+
+void Program::retire(){
     for(auto&& [name, ptr] : memory_elements_){
-        SharedSegmentDescriptor* segment = dynamic_cast<SharedSegmentDescriptor*>(ptr);
-        if(!ptr->is_reference() && !segment)
-            manager_.record_error(MEMORY_LEAK, "The element '" + name + "' is still reachable.", name_);
-        if(segment)
-            segment->erase_program(this);
-            
+        visit_element(*ptr, Overloaded{
+            [this](SharedSegmentDescriptor& segment){ segment.erase_program(this); },
+            [](ReferenceDescriptor&){},
+            [this](MemoryElement& element){
+                manager_.record_error(ErrorCode::ElementStillReachable, name_, {element.get_name()});
+            }
+        });
     }
 }
 
@@ -4,12 +4,21 @@
 
 namespace MemoryNameSpace{
 
-IMemoryElement* ReferenceDescriptor::get_element() const {
-    return manager_.get_element(target_name_);
+ReferenceDescriptor::~ReferenceDescriptor() {
+    if(name_ != nullptr) manager_.release_name(*name_);
+    if(target_name_ != nullptr) manager_.release_name(*target_name_);
+}
+
+IMemoryElement* ReferenceDescriptor::get_element() const noexcept {
+    return target_;
 }
 
 const std::string& ReferenceDescriptor::get_name() const noexcept {
-    return name_;
+    return name_->name;
+}
+
+size_t ReferenceDescriptor::get_name_hash() const noexcept {
+    return name_->hash;
 }
 
 size_t ReferenceDescriptor::get_size() const noexcept {
@@ -33,7 +42,15 @@ void ReferenceDescriptor::set_offset(size_t offset) noexcept {
 }
 
 bool ReferenceDescriptor::is_valid() const noexcept {
-    return (get_element() != nullptr);
+    return (target_ != nullptr);
+}
+
+const IMemoryElement* ReferenceDescriptor::get_target() const noexcept {
+    return target_;
+}
+
+void ReferenceDescriptor::invalidate() noexcept {
+    target_ = nullptr;
 }
 
 void ReferenceDescriptor::get_raw_value(std::byte* value, size_t begin, size_t end) const {
@@ -52,16 +69,12 @@ bool ReferenceDescriptor::is_possible_to_destroy(__attribute__((unused)) const s
 
 bool ReferenceDescriptor::destroy(Program& prog){
     prog.erase_element(this);
-    manager_.erase_element(this);
+    manager_.erase_element(this, prog);
     return true;
 }
 
 const std::string& ReferenceDescriptor::get_ref_name() const noexcept {
-    return name_;
-}
-
-bool ReferenceDescriptor::is_reference() const noexcept {
-    return true;
+    return name_->name;
 }
 
 }
\ No newline at end of file
@@ -1,33 +1,68 @@
 #include <Memory/SharedSegmentDescriptor.hpp>
+#include <numeric>
+#include <cstdint>
+#include <tbb/parallel_for.h>
 
 namespace MemoryNameSpace{
 
 void SharedSegmentDescriptor::insert_program(const Program* program){
-    programs_.insert({program->get_name(), program});
+    programs_.insert(program->get_id());
 }
 
 void SharedSegmentDescriptor::erase_program(const Program* program){
-    auto it = programs_.find(program->get_name());
-    if(it != programs_.end()) programs_.erase(it);
+    programs_.erase(program->get_id());
 }
 
-bool SharedSegmentDescriptor::check_access(const std::string& name) const {
-    auto it = programs_.find(name);
-    if(it != programs_.end()) return true;
+bool SharedSegmentDescriptor::check_access(std::string_view name) const {
+    const Program* program = manager_.find_program(name);
+    return program != nullptr && programs_.contains(program->get_id());
+}
+
+bool SharedSegmentDescriptor::check_access_with_error(std::string_view prog) const {
+    if(check_access(prog)) return true;
+    manager_.record_error(ErrorCode::SegmentAccessDenied, prog, {get_name()});
     return false;
 }
 
+void SharedSegmentDescriptor::run_chunks(std::byte* data, size_t count, size_t elem_size, ChunkCallback callback, void* context){
+    if(count == 0) return;
+    // Elements before the first cache-line boundary form a separate head chunk,
+    // so no two parallel chunks write to the same line.
+    size_t head = 0;
+    size_t misalignment = (CACHE_LINE - reinterpret_cast<uintptr_t>(data) % CACHE_LINE) % CACHE_LINE;
+    if(misalignment % elem_size == 0) head = std::min(count, misalignment / elem_size);
+    size_t line_elems = std::lcm(CACHE_LINE, elem_size) / elem_size;
+    size_t chunk = std::max(line_elems, CHUNK_BYTES / elem_size / line_elems * line_elems);
+
+    if(head != 0) callback(context, data, head);
+    size_t rest = count - head;
+    std::byte* base = data + head * elem_size;
+    size_t chunks = (rest + chunk - 1) / chunk;
+    if(chunks <= 1){
+        if(rest != 0) callback(context, base, rest);
+        return;
+    }
+    tbb::parallel_for(size_t{0}, chunks, [&](size_t index){
+        size_t begin = index * chunk;
+        callback(context, base + begin * elem_size, std::min(chunk, rest - begin));
+    });
+}
+
 bool SharedSegmentDescriptor::is_last() const {
     return programs_.size() == 1;
 }
 
+const ProgramSet& SharedSegmentDescriptor::get_programs() const noexcept {
+    return programs_;
+}
+
 bool SharedSegmentDescriptor::is_possible_to_destroy(const std::string& prog) const {
-    if(programs_.find(prog) == programs_.end()){
-        manager_.record_error(ACCESS_ERROR, "Program doesn't have acces for segment." + name_, prog);
+    if(!check_access(prog)){
+        manager_.record_error(ErrorCode::SegmentAccessDenied, prog, {get_name()});
         return false;
     }
     if(!is_last()){
-        manager_.record_error(MEMORY_LEAK, "The segment '" + name_ + "' is is still used by others programs.", prog);
+        manager_.record_error(ErrorCode::SegmentInUse, prog, {get_name()});
         return false;
     }
     return true;
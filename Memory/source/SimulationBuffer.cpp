@@ -0,0 +1,139 @@
+#include <Memory/SimulationBuffer.hpp>
+#include <iterator>
+#include <new>
+
+namespace MemoryNameSpace{
+
+SimulationBuffer::SimulationBuffer(size_t capacity, AllocatorPolicy policy)
+        : capacity_(capacity), policy_(policy), free_bytes_(0) {
+    compact(0);
+}
+
+void SimulationBuffer::insert_free(size_t offset, size_t size){
+    auto block = by_offset_.emplace(offset, size).first;
+    try{
+        by_size_.emplace(size, offset);
+    }
+    catch(...){
+        by_offset_.erase(block);
+        throw;
+    }
+}
+
+void SimulationBuffer::erase_free(std::map<size_t, size_t>::iterator block){
+    by_size_.erase({block->second, block->first});
+    by_offset_.erase(block);
+}
+
+std::map<size_t, size_t>::iterator SimulationBuffer::choose_block(size_t size, size_t alignment){
+    auto fits = [size, alignment](size_t offset, size_t block_size){
+        return block_size >= size && block_size - size >= alignment_padding(offset, alignment);
+    };
+    // No block fits when even the largest one is too small, so only
+    // fitting allocations pay for the scans.
+    if(by_size_.empty() || by_size_.rbegin()->first < size) return by_offset_.end();
+    switch(policy_){
+    case AllocatorPolicy::BestFit:
+        for(auto it = by_size_.lower_bound({size, 0}); it != by_size_.end(); ++it)
+            if(fits(it->second, it->first)) return by_offset_.find(it->second);
+        return by_offset_.end();
+    case AllocatorPolicy::WorstFit:
+        for(auto it = by_size_.rbegin(); it != by_size_.rend() && it->first >= size; ++it){
+            // Among blocks of the largest fitting size, take the lowest address.
+            auto lowest = by_size_.lower_bound({it->first, 0});
+            for(auto same = lowest; same != by_size_.end() && same->first == it->first; ++same)
+                if(fits(same->second, same->first)) return by_offset_.find(same->second);
+            it = std::make_reverse_iterator(std::next(lowest));
+        }
+        return by_offset_.end();
+    case AllocatorPolicy::FirstFit: break;
+    }
+    for(auto it = by_offset_.begin(); it != by_offset_.end(); ++it)
+        if(fits(it->first, it->second)) return it;
+    return by_offset_.end();
+}
+
+std::expected<size_t, BufferError> SimulationBuffer::try_allocate_block(size_t size, size_t alignment) noexcept {
+    auto block = choose_block(size, alignment);
+    if(block == by_offset_.end()) return std::unexpected(BufferError::Overflow);
+    size_t padding = alignment_padding(block->first, alignment);
+    size_t offset = block->first + padding;
+    size_t remaining = block->second - padding - size;
+    // The nodes of the chosen block are reused for the padding or the
+    // tail, so an allocation is needed only when both remain.
+    auto offset_node = by_offset_.extract(block);
+    auto size_node = by_size_.extract({offset_node.mapped(), offset_node.key()});
+    if(padding != 0 && remaining != 0){
+        try{
+            insert_free(offset + size, remaining);
+        }
+        catch(const std::bad_alloc&){
+            by_offset_.insert(std::move(offset_node));
+            by_size_.insert(std::move(size_node));
+            return std::unexpected(BufferError::Overflow);
+        }
+    }
+    if(padding != 0 || remaining != 0){
+        if(padding != 0) offset_node.mapped() = padding;
+        else{
+            offset_node.key() = offset + size;
+            offset_node.mapped() = remaining;
+        }
+        size_node.value() = {offset_node.mapped(), offset_node.key()};
+        by_offset_.insert(std::move(offset_node));
+        by_size_.insert(std::move(size_node));
+    }
+    free_bytes_ -= size;
+    blocks_dirty_ = true;
+    return offset;
+}
+
+std::expected<void, BufferError> SimulationBuffer::try_destroy_block(size_t offset, size_t size){
+    if((offset > capacity_) || (size > capacity_ - offset))
+        return std::unexpected(BufferError::OutOfRange);
+    auto next = by_offset_.upper_bound(offset);
+    auto prev = (next != by_offset_.begin()) ? std::prev(next) : by_offset_.end();
+    if(((next != by_offset_.end()) && (offset + size > next->first)) || ((prev != by_offset_.end()) && (prev->first + prev->second > offset)))
+        return std::unexpected(BufferError::DoubleFree);
+    if(size == 0) return {};
+    bool merge_prev = (prev != by_offset_.end()) && (prev->first + prev->second == offset);
+    bool merge_next = (next != by_offset_.end()) && (next->first == offset + size);
+    if(!merge_prev && !merge_next) insert_free(offset, size);
+    else{
+        // Merging reuses the nodes of the grown block, so nothing here allocates.
+        auto offset_node = by_offset_.extract(merge_prev ? prev : next);
+        auto size_node = by_size_.extract({offset_node.mapped(), offset_node.key()});
+        if(!merge_prev) offset_node.key() = offset;
+        offset_node.mapped() += size;
+        if(merge_prev && merge_next){
+            offset_node.mapped() += next->second;
+            erase_free(next);
+        }
+        size_node.value() = {offset_node.mapped(), offset_node.key()};
+        by_offset_.insert(std::move(offset_node));
+        by_size_.insert(std::move(size_node));
+    }
+    free_bytes_ += size;
+    blocks_dirty_ = true;
+    return {};
+}
+
+const std::vector<Block>& SimulationBuffer::get_blocks() const {
+    if(blocks_dirty_){
+        blocks_.clear();
+        blocks_.reserve(by_offset_.size());
+        for(auto [offset, size] : by_offset_) blocks_.push_back(Block{offset, size});
+        blocks_dirty_ = false;
+    }
+    return blocks_;
+}
+
+void SimulationBuffer::compact(size_t used){
+    by_offset_.clear();
+    by_size_.clear();
+    free_bytes_ = used < capacity_ ? capacity_ - used : 0;
+    if(free_bytes_ != 0) insert_free(used, free_bytes_);
+    blocks_dirty_ = true;
+}
+
+}
@@ -0,0 +1,143 @@
+#include <Memory/SystemReport.hpp>
+#include <Memory/SharedSegmentDescriptor.hpp>
+#include <algorithm>
+#include <bit>
+#include <tbb/parallel_reduce.h>
+#include <tbb/blocked_range.h>
+#include <tbb/task_arena.h>
+
+namespace MemoryNameSpace{
+
+namespace{
+
+constexpr size_t GRAIN_SIZE = 1 << 12;  ///< Slots or blocks per TBB task
+
+/**
+ * @struct Partial
+ * @brief Part of the report gathered from a subrange of the pass
+ */
+struct Partial{
+    std::vector<size_t> program_usage;                              ///< Bytes by ProgramId
+    std::array<size_t, ELEMENT_KINDS> kind_usage{};                 ///< Bytes by ElementKind
+    std::array<size_t, ELEMENT_KINDS> kind_count{};                 ///< Elements by ElementKind
+    std::vector<SegmentFanOut> segments;                            ///< Segments in the subrange
+    std::array<size_t, FREE_BLOCK_CLASSES> free_block_histogram{};  ///< Free blocks by size class
+    size_t free = 0;                                                ///< Bytes in free blocks
+    size_t largest_free_block = 0;                                  ///< Largest free block
+};
+
+/**
+ * @brief Read-only inputs of the pass
+ */
+struct Sources{
+    const ElementTable& table;          ///< Element metadata
+    const std::vector<Block>& blocks;   ///< Free blocks of the buffer
+    size_t programs;                    ///< Size of the program registry
+};
+
+/**
+ * @brief Adds the element slots and free blocks of [begin, end) to a partial report
+ *
+ * Indices below the slot count are element slots, the rest are free blocks.
+ */
+void scan(const Sources& sources, size_t begin, size_t end, Partial& partial){
+    std::span<const size_t> sizes = sources.table.get_sizes();
+    std::span<const ElementKind> kinds = sources.table.get_kinds();
+    std::span<const ProgramId> owners = sources.table.get_owners();
+    const size_t slots = sizes.size();
+
+    for(size_t index = begin; index < std::min(end, slots); ++index){
+        const IMemoryElement* element = sources.table.get_element(static_cast<ElementId>(index));
+        if(element == nullptr) continue;
+        size_t size = sizes[index];
+        ElementKind kind = kinds[index];
+        partial.kind_usage[static_cast<size_t>(kind)] += size;
+        ++partial.kind_count[static_cast<size_t>(kind)];
+        if(kind != ElementKind::Shared){
+            if(owners[index] < sources.programs) partial.program_usage[owners[index]] += size;
+            continue;
+        }
+        const ProgramSet& programs = static_cast<const SharedSegmentDescriptor*>(element)->get_programs();
+        programs.for_each([&](ProgramId program){
+            if(program < sources.programs) partial.program_usage[program] += size;
+        });
+        partial.segments.push_back(SegmentFanOut{static_cast<ElementId>(index), size, programs.size()});
+    }
+
+    for(size_t index = std::max(begin, slots); index < end; ++index){
+        size_t size = sources.blocks[index - slots].size;
+        partial.free += size;
+        partial.largest_free_block = std::max(partial.largest_free_block, size);
+        ++partial.free_block_histogram[std::bit_width(size | 1) - 1];
+    }
+}
+
+/**
+ * @brief Merges the partial report of a later subrange into an earlier one
+ */
+Partial combine(Partial left, const Partial& right){
+    for(size_t i = 0; i < left.program_usage.size(); ++i) left.program_usage[i] += right.program_usage[i];
+    for(size_t i = 0; i < ELEMENT_KINDS; ++i){
+        left.kind_usage[i] += right.kind_usage[i];
+        left.kind_count[i] += right.kind_count[i];
+    }
+    left.segments.insert(left.segments.end(), right.segments.begin(), right.segments.end());
+    for(size_t i = 0; i < FREE_BLOCK_CLASSES; ++i) left.free_block_histogram[i] += right.free_block_histogram[i];
+    left.free += right.free;
+    left.largest_free_block = std::max(left.largest_free_block, right.largest_free_block);
+    return left;
+}
+
+}
+
+SystemReport make_system_report(const IManager& manager, size_t parallel_threshold){
+    const ElementTable& table = manager.get_element_table();
+    const std::vector<Block>& blocks = manager.get_free_blocks();
+    Sources sources{table, blocks, manager.get_stats().program_usage.size()};
+    const size_t work = table.slot_count() + blocks.size();
+
+    Partial identity;
+    identity.program_usage.assign(sources.programs, 0);
+    SystemReport report;
+    report.parallel = work >= parallel_threshold && tbb::this_task_arena::max_concurrency() > 1;
+
+    Partial total;
+    if(!report.parallel){
+        total = std::move(identity);
+        scan(sources, 0, work, total);
+    }
+    else{
+        total = tbb::parallel_reduce(tbb::blocked_range<size_t>(0, work, GRAIN_SIZE), identity,
+            [&](const tbb::blocked_range<size_t>& range, Partial partial){
+                scan(sources, range.begin(), range.end(), partial);
+                return partial;
+            },
+            [](Partial left, const Partial& right){ return combine(std::move(left), right); });
+        std::sort(total.segments.begin(), total.segments.end(),
+                  [](const SegmentFanOut& a, const SegmentFanOut& b){ return a.id < b.id; });
+    }
+
+    // Leftovers of deleted programs stay in the table under their old ids.
+    for(ProgramId id = 0; id < sources.programs; ++id)
+        if(manager.find_program(id) == nullptr) total.program_usage[id] = 0;
+
+    report.program_usage = std::move(total.program_usage);
+    report.kind_usage = total.kind_usage;
+    report.kind_count = total.kind_count;
+    // References have no table slot; every other element in the manager has one.
+    report.kind_count[static_cast<size_t>(ElementKind::Reference)] = manager.element_count() - std::min(manager.element_count(), table.size());
+    report.segments = std::move(total.segments);
+    report.dangling_references = manager.dungling_reference().size();
+    report.free_block_histogram = total.free_block_histogram;
+    for(size_t usage : report.kind_usage) report.used += usage;
+    report.free = total.free;
+    report.largest_free_block = total.largest_free_block;
+    const ErrorLog& log = manager.get_error_log();
+    for(size_t type = 0; type < report.errors.size(); ++type){
+        report.errors[type] = log.count(static_cast<error_t>(type));
+        report.errors_total[type] = log.total(static_cast<error_t>(type));
+    }
+    return report;
+}
+
+}
@@ -0,0 +1,370 @@
+#include <Memory/Trace.hpp>
+#include <Memory/Manager.hpp>
+#include <Memory/Program.hpp>
+#include <Memory/VariableDescriptor.hpp>
+#include <Memory/ArrayDescriptor.hpp>
+#include <Memory/SharedSegmentDescriptor.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <tuple>
+
+namespace MemoryNameSpace{
+
+namespace{
+
+constexpr std::array<char, 4> MAGIC = {'M', 'T', 'R', 'C'};  ///< Signature of a trace
+constexpr uint8_t VERSION = 1;                                ///< Current format version
+constexpr size_t NO_OFFSET = std::numeric_limits<size_t>::max(); ///< Offset of an element whose allocation failed
+
+void write_varint(std::ostream& out, uint64_t value){
+    while(value >= 0x80){
+        out.put(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.put(static_cast<char>(value));
+}
+
+std::expected<uint64_t, TraceError> read_varint(std::istream& in){
+    uint64_t value = 0;
+    for(unsigned shift = 0; shift < 64; shift += 7){
+        int byte = in.get();
+        if(byte == std::char_traits<char>::eof()) return std::unexpected(TraceError::Truncated);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if((byte & 0x80) == 0) return value;
+    }
+    return std::unexpected(TraceError::Corrupted);
+}
+
+bool has_size(TraceOp op) noexcept {
+    return op == TraceOp::Allocate || op == TraceOp::Resize;
+}
+
+/**
+ * @brief Computes the percentiles of a set of latencies
+ */
+LatencySummary summarize(std::vector<uint64_t>& latencies){
+    LatencySummary summary;
+    summary.count = latencies.size();
+    if(latencies.empty()) return summary;
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](size_t percent){ return latencies[(latencies.size() - 1) * percent / 100]; };
+    summary.p50 = percentile(50);
+    summary.p90 = percentile(90);
+    summary.p99 = percentile(99);
+    summary.max = latencies.back();
+    return summary;
+}
+
+/**
+ * @brief Collects latencies and peaks while a trace is replayed
+ */
+class ReplayMeter{
+private:
+    std::vector<uint64_t> allocate_;     ///< Allocation latencies
+    std::vector<uint64_t> free_;         ///< Free latencies
+    std::vector<uint64_t> defragment_;   ///< Defragmentation latencies
+    ReplayResult result_;                ///< Counters and peaks
+
+public:
+    /**
+     * @brief Runs an operation and records its latency
+     */
+    template<typename F>
+    auto time(TraceOp op, F&& operation){
+        auto start = std::chrono::steady_clock::now();
+        auto outcome = operation();
+        auto elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        result_.elapsed += elapsed;
+        (op == TraceOp::Allocate ? allocate_ : op == TraceOp::Free ? free_ : defragment_).push_back(elapsed);
+        return outcome;
+    }
+
+    /**
+     * @brief Counts a failed operation
+     */
+    void fail() noexcept { ++result_.failed; }
+
+    /**
+     * @brief Updates the peaks after an event
+     */
+    void sample(size_t used, size_t free, size_t largest_free_block) noexcept {
+        ++result_.events;
+        result_.peak_used = std::max(result_.peak_used, used);
+        if(free != 0)
+            result_.peak_fragmentation = std::max(result_.peak_fragmentation,
+                1.0 - static_cast<double>(largest_free_block) / static_cast<double>(free));
+    }
+
+    /**
+     * @brief Gets the result of the replay
+     */
+    ReplayResult finish(){
+        result_.allocate = summarize(allocate_);
+        result_.free = summarize(free_);
+        result_.defragment = summarize(defragment_);
+        if(result_.elapsed != 0)
+            result_.throughput = static_cast<double>(result_.events) * 1e9 / static_cast<double>(result_.elapsed);
+        return result_;
+    }
+};
+
+/**
+ * @brief Gets the slot of a handle, growing the table if needed
+ */
+template<typename T>
+T& slot(std::vector<T>& table, uint32_t handle, T empty){
+    if(handle >= table.size()) table.resize(static_cast<size_t>(handle) + 1, empty);
+    return table[handle];
+}
+
+}
+
+void write_trace(std::ostream& out, std::span<const TraceEvent> events){
+    out.write(MAGIC.data(), MAGIC.size());
+    out.put(static_cast<char>(VERSION));
+    write_varint(out, events.size());
+    uint64_t previous = 0;
+    for(const TraceEvent& event : events){
+        uint64_t timestamp = std::max(event.timestamp, previous);
+        out.put(static_cast<char>(static_cast<uint8_t>(event.op) | (static_cast<uint8_t>(event.kind) << 4)));
+        write_varint(out, timestamp - previous);
+        write_varint(out, event.program);
+        write_varint(out, event.element);
+        if(has_size(event.op)) write_varint(out, event.size);
+        previous = timestamp;
+    }
+}
+
+std::expected<std::vector<TraceEvent>, TraceError> read_trace(std::istream& in){
+    std::array<char, 4> magic{};
+    if(!in.read(magic.data(), magic.size())) return std::unexpected(TraceError::Truncated);
+    if(magic != MAGIC) return std::unexpected(TraceError::BadMagic);
+    int version = in.get();
+    if(version == std::char_traits<char>::eof()) return std::unexpected(TraceError::Truncated);
+    if(version > VERSION) return std::unexpected(TraceError::UnsupportedVersion);
+    auto count = read_varint(in);
+    if(!count) return std::unexpected(count.error());
+
+    std::vector<TraceEvent> events;
+    events.reserve(std::min<uint64_t>(*count, 1 << 20));
+    uint64_t timestamp = 0;
+    for(uint64_t i = 0; i < *count; ++i){
+        int header = in.get();
+        if(header == std::char_traits<char>::eof()) return std::unexpected(TraceError::Truncated);
+        TraceEvent event;
+        uint8_t op = static_cast<uint8_t>(header) & 0x0f;
+        uint8_t kind = static_cast<uint8_t>(header) >> 4;
+        if(op > static_cast<uint8_t>(TraceOp::Defragment) || kind > static_cast<uint8_t>(ElementKind::Reference))
+            return std::unexpected(TraceError::Corrupted);
+        event.op = static_cast<TraceOp>(op);
+        event.kind = static_cast<ElementKind>(kind);
+
+        auto delta = read_varint(in);
+        auto program = delta ? read_varint(in) : delta;
+        auto element = program ? read_varint(in) : program;
+        if(!element) return std::unexpected(element.error());
+        if(*program > std::numeric_limits<ProgramId>::max() || *element > std::numeric_limits<uint32_t>::max())
+            return std::unexpected(TraceError::Corrupted);
+        timestamp += *delta;
+        event.timestamp = timestamp;
+        event.program = static_cast<ProgramId>(*program);
+        event.element = static_cast<uint32_t>(*element);
+        if(has_size(event.op)){
+            auto size = read_varint(in);
+            if(!size) return std::unexpected(size.error());
+            event.size = *size;
+        }
+        events.push_back(event);
+    }
+    return events;
+}
+
+TraceRecorder::TraceRecorder() : start_(std::chrono::steady_clock::now()) {}
+
+uint64_t TraceRecorder::now() const noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_).count());
+}
+
+void TraceRecorder::record_allocate(ProgramId program, const IMemoryElement& element){
+    ElementId id = element.get_id();
+    if(id == INVALID_ELEMENT_ID) return;
+    uint32_t handle = next_handle_++;
+    slot(handles_, id, NO_HANDLE) = handle;
+    events_.push_back(TraceEvent{now(), element.get_size(), handle, program, TraceOp::Allocate, element.get_kind()});
+}
+
+void TraceRecorder::record_free(ProgramId program, ElementId element){
+    if(element >= handles_.size() || handles_[element] == NO_HANDLE) return;
+    events_.push_back(TraceEvent{now(), 0, handles_[element], program, TraceOp::Free, ElementKind::Variable});
+    handles_[element] = NO_HANDLE;
+}
+
+void TraceRecorder::record_defragment(){
+    events_.push_back(TraceEvent{now(), 0, 0, 0, TraceOp::Defragment, ElementKind::Variable});
+}
+
+std::vector<TraceEvent> generate_trace(const TraceWorkload& workload){
+    std::mt19937_64 random(workload.seed);
+    std::lognormal_distribution<double> sizes(workload.size_log_mean, workload.size_log_sigma);
+    std::exponential_distribution<double> lifetimes(1.0 / std::max(workload.mean_lifetime, 1e-9));
+    const double max_size = static_cast<double>(std::max<size_t>(workload.max_size, 1));
+    const uint32_t programs = std::max<uint32_t>(workload.programs, 1);
+
+    // Pending frees ordered by time: (timestamp, handle, program).
+    using Pending = std::tuple<uint64_t, uint32_t, ProgramId>;
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<>> pending;
+    std::vector<TraceEvent> events;
+    events.reserve(2 * workload.allocations);
+    auto free_until = [&](uint64_t time){
+        while(!pending.empty() && std::get<0>(pending.top()) <= time){
+            auto [timestamp, handle, program] = pending.top();
+            pending.pop();
+            events.push_back(TraceEvent{timestamp, 0, handle, program, TraceOp::Free, ElementKind::Variable});
+        }
+    };
+
+    for(size_t i = 0; i < workload.allocations; ++i){
+        uint64_t time = i * workload.interval;
+        free_until(time);
+        uint32_t handle = static_cast<uint32_t>(i);
+        ProgramId program = static_cast<ProgramId>(i % programs);
+        auto size = static_cast<uint64_t>(std::clamp(std::round(sizes(random)), 1.0, max_size));
+        events.push_back(TraceEvent{time, size, handle, program, TraceOp::Allocate, ElementKind::Variable});
+        // A lifetime below one interval still ends after the allocation.
+        auto lifetime = static_cast<uint64_t>(lifetimes(random) * static_cast<double>(workload.interval));
+        pending.emplace(time + std::max<uint64_t>(lifetime, 1), handle, program);
+        if(workload.defragment_every != 0 && (i + 1) % workload.defragment_every == 0)
+            events.push_back(TraceEvent{time, 0, 0, 0, TraceOp::Defragment, ElementKind::Variable});
+    }
+    free_until(std::numeric_limits<uint64_t>::max());
+    return events;
+}
+
+ReplayResult replay_trace(std::span<const TraceEvent> events, IBuffer& buffer){
+    ReplayMeter meter;
+    std::vector<size_t> offsets;
+    std::vector<size_t> sizes;
+
+    auto allocate = [&](const TraceEvent& event){
+        auto offset = meter.time(TraceOp::Allocate, [&]{ return buffer.try_allocate_block(event.size); });
+        slot(offsets, event.element, NO_OFFSET) = offset ? *offset : NO_OFFSET;
+        slot(sizes, event.element, size_t{0}) = event.size;
+        if(!offset) meter.fail();
+    };
+    auto destroy = [&](const TraceEvent& event){
+        size_t& offset = slot(offsets, event.element, NO_OFFSET);
+        if(offset == NO_OFFSET){
+            meter.fail();
+            return;
+        }
+        auto result = meter.time(TraceOp::Free, [&]{ return buffer.try_destroy_block(offset, sizes[event.element]); });
+        if(!result) meter.fail();
+        offset = NO_OFFSET;
+    };
+    auto defragment = [&]{
+        meter.time(TraceOp::Defragment, [&]{
+            std::vector<uint32_t> live;
+            for(uint32_t handle = 0; handle < offsets.size(); ++handle)
+                if(offsets[handle] != NO_OFFSET) live.push_back(handle);
+            std::sort(live.begin(), live.end(), [&](uint32_t a, uint32_t b){ return offsets[a] < offsets[b]; });
+            size_t packed = 0;
+            for(uint32_t handle : live){
+                if(offsets[handle] != packed && buffer.get_data() != nullptr)
+                    std::memmove(buffer.get_data() + packed, buffer.get_data() + offsets[handle], sizes[handle]);
+                offsets[handle] = packed;
+                packed += sizes[handle];
+            }
+            buffer.compact(packed);
+            return packed;
+        });
+    };
+
+    for(const TraceEvent& event : events){
+        switch(event.op){
+        case TraceOp::Allocate: allocate(event); break;
+        case TraceOp::Free: destroy(event); break;
+        case TraceOp::Resize:
+            destroy(event);
+            allocate(event);
+            break;
+        case TraceOp::Defragment: defragment(); break;
+        }
+        size_t free = buffer.get_free_memory();
+        meter.sample(buffer.get_capacity() - free, free, buffer.get_largest_free_block());
+    }
+    return meter.finish();
+}
+
+ReplayResult replay_trace(std::span<const TraceEvent> events, IManager& manager){
+    ReplayMeter meter;
+    std::vector<Program*> programs;
+    std::vector<std::string> names;
+
+    auto program_of = [&](ProgramId id){
+        Program*& program = slot(programs, id, static_cast<Program*>(nullptr));
+        if(program == nullptr)
+            program = manager.add_program("trace_" + std::to_string(id), "trace", manager.get_capacity());
+        return program;
+    };
+    auto allocate = [&](const TraceEvent& event){
+        Program* program = program_of(event.program);
+        std::string& name = slot(names, event.element, std::string{});
+        name = "e" + std::to_string(event.element);
+        size_t size = static_cast<size_t>(event.size);
+        IMemoryElement* element = meter.time(TraceOp::Allocate, [&]() -> IMemoryElement* {
+            if(program == nullptr) return nullptr;
+            switch(event.kind){
+            case ElementKind::Array: return program->allocate_element<ArrayDescriptor>(name, size, size_t{1});
+            case ElementKind::Shared: return program->allocate_element<SharedSegmentDescriptor>(name, size, size_t{1}, program);
+            case ElementKind::Variable:
+            case ElementKind::Reference: break;
+            }
+            return program->allocate_element<VariableDescriptor>(name, size);
+        });
+        if(element == nullptr){
+            meter.fail();
+            name.clear();
+        }
+    };
+    auto destroy = [&](const TraceEvent& event){
+        Program* program = program_of(event.program);
+        std::string& name = slot(names, event.element, std::string{});
+        if(program == nullptr || name.empty()){
+            meter.fail();
+            return;
+        }
+        if(!meter.time(TraceOp::Free, [&]{ return program->destroy_element(name); })) meter.fail();
+        name.clear();
+    };
+
+    for(const TraceEvent& event : events){
+        switch(event.op){
+        case TraceOp::Allocate: allocate(event); break;
+        case TraceOp::Free: destroy(event); break;
+        case TraceOp::Resize:
+            destroy(event);
+            allocate(event);
+            break;
+        case TraceOp::Defragment:
+            meter.time(TraceOp::Defragment, [&]{
+                manager.defragment_memory();
+                return true;
+            });
+            break;
+        }
+        MemoryStats stats = manager.get_stats();
+        meter.sample(stats.used, stats.free, stats.largest_free_block);
+    }
+    return meter.finish();
+}
+
+}
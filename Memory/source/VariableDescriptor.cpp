@@ -1,5 +1,31 @@
 #include <Memory/VariableDescriptor.hpp>
+#include <algorithm>
 
 namespace MemoryNameSpace{
 
-}
\ No newline at end of file
+bool VariableDescriptor::check_bytes(size_t begin, size_t count) const {
+    size_t size = table_.get_size(id_);
+    if(begin > size || count > size - begin){
+        manager_.record_error(ErrorCode::ByteRangeOutOfBounds, get_owner_name(), ErrorContext{get_name(), {}, {begin, begin + count, size}});
+        return false;
+    }
+    return true;
+}
+
+std::byte* VariableDescriptor::byte_data(size_t begin) const {
+    return raw_data() + begin;
+}
+
+bool VariableDescriptor::read_bytes(size_t begin, std::span<std::byte> out) const {
+    if(!check_bytes(begin, out.size())) return false;
+    std::copy_n(byte_data(begin), out.size(), out.data());
+    return true;
+}
+
+bool VariableDescriptor::write_bytes(size_t begin, std::span<const std::byte> bytes){
+    if(!check_bytes(begin, bytes.size())) return false;
+    std::copy_n(bytes.data(), bytes.size(), byte_data(begin));
+    return true;
+}
+
+}
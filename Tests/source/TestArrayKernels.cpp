@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <Memory/ArrayKernels.hpp>
+#include <Memory/Manager.hpp>
+#include <Memory/Program.hpp>
+#include <Memory/ArrayDescriptor.hpp>
+#include <Memory/VariableDescriptor.hpp>
+#include <Memory/SharedSegmentDescriptor.hpp>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <cstring>
+
+using namespace MemoryNameSpace;
+
+namespace{
+
+/**
+ * @brief Buffer whose data starts one byte past an aligned address
+ *
+ * Aligned offsets in it are misaligned addresses, like element data
+ * packed by an external allocator.
+ */
+template<size_t capacity>
+class ShiftedBuffer final : public IBuffer{
+private:
+    Buffer<capacity + 1> storage_;
+    Buffer<capacity> blocks_;
+
+public:
+    std::byte* get_data() noexcept override { return storage_.get_data() + 1; }
+    const std::byte* get_data() const noexcept override { return storage_.get_data() + 1; }
+    size_t get_capacity() const noexcept override { return capacity; }
+    std::expected<size_t, BufferError> try_allocate_block(size_t size, size_t alignment = 1) noexcept override {
+        return blocks_.try_allocate_block(size, alignment);
+    }
+    std::expected<void, BufferError> try_destroy_block(size_t offset, size_t size) override {
+        return blocks_.try_destroy_block(offset, size);
+    }
+    const std::vector<Block>& get_blocks() const noexcept override { return blocks_.get_blocks(); }
+    size_t get_free_block_count() const noexcept override { return blocks_.get_free_block_count(); }
+    void compact(size_t used) override { blocks_.compact(used); }
+    size_t get_free_memory() const noexcept override { return blocks_.get_free_memory(); }
+    size_t get_largest_free_block() const noexcept override { return blocks_.get_largest_free_block(); }
+};
+
+template<typename T>
+std::vector<T> make_values(size_t count){
+    std::vector<T> values(count);
+    for(size_t i = 0; i < count; ++i)
+        values[i] = static_cast<T>((i * 7919) % 1000) - static_cast<T>(std::is_signed_v<T> ? 500 : 0);
+    return values;
+}
+
+template<typename T>
+void check_kernels(size_t count){
+    std::vector<T> values = make_values<T>(count);
+    std::span<const T> data(values);
+    
+    sum_t<T> expected_sum = std::accumulate(values.begin(), values.end(), sum_t<T>{});
+    EXPECT_EQ(reduce_sum(data), expected_sum);
+    
+    auto [low, high] = std::minmax_element(values.begin(), values.end());
+    EXPECT_EQ(reduce_minmax(data), std::make_pair(*low, *high));
+    
+    EXPECT_EQ(reduce_count(data, Compare::Less, T{100}), static_cast<size_t>(std::count_if(values.begin(), values.end(), [](T x){ return x < T{100}; })));
+    EXPECT_EQ(reduce_count(data, Compare::Equal, values[count / 2]), static_cast<size_t>(std::count(values.begin(), values.end(), values[count / 2])));
+    
+    sum_t<T> expected_dot = std::inner_product(values.begin(), values.end(), values.begin(), sum_t<T>{},
+        std::plus<>{}, [](T a, T b){ return static_cast<sum_t<T>>(a) * static_cast<sum_t<T>>(b); });
+    EXPECT_EQ(reduce_dot(data, data), expected_dot);
+    
+    std::vector<T> expected_scan(count);
+    std::inclusive_scan(values.begin(), values.end(), expected_scan.begin());
+    inclusive_prefix_sum(std::span<T>(values));
+    EXPECT_EQ(values, expected_scan);
+}
+
+}
+
+TEST(ArrayKernelsTest, SerialKernels) {
+    check_kernels<int>(1001);
+    check_kernels<long long>(1001);
+    check_kernels<size_t>(1001);
+    check_kernels<double>(1001);
+}
+
+TEST(ArrayKernelsTest, ParallelKernels) {
+    check_kernels<int>(4 * PARALLEL_THRESHOLD + 3);
+    check_kernels<long long>(4 * PARALLEL_THRESHOLD + 3);
+    check_kernels<size_t>(4 * PARALLEL_THRESHOLD + 3);
+    check_kernels<double>(4 * PARALLEL_THRESHOLD + 3);
+}
+
+TEST(ArrayKernelsTest, IntSumDoesNotOverflow) {
+    std::vector<int> values(16, std::numeric_limits<int>::max());
+    EXPECT_EQ(reduce_sum(std::span<const int>(values)), 16LL * std::numeric_limits<int>::max());
+}
+
+TEST(ArrayKernelsTest, ArrayReductionsInPlace) {
+    Manager<1024> manager;
+    Program* prog = manager.add_program("prog", "prog.cpp", 1024);
+    ArrayDescriptor* arr = prog->allocate_element<ArrayDescriptor>("arr", 8 * sizeof(int), sizeof(int));
+    SharedSegmentDescriptor* seg = prog->allocate_element<SharedSegmentDescriptor>("seg", 8 * sizeof(int), sizeof(int), prog);
+    ArrayDescriptor* other = prog->allocate_element<ArrayDescriptor>("other", 4 * sizeof(int), sizeof(int));
+    const int values[] = {5, -3, 8, 0, 2, 2, -7, 1};
+    ASSERT_TRUE(arr->write_range<int>(0, values));
+    ASSERT_TRUE(seg->fill<int>(0, 8, 2));
+    
+    EXPECT_EQ(arr->sum<int>(), 8);
+    EXPECT_EQ(arr->min<int>(), -7);
+    EXPECT_EQ(arr->max<int>(), 8);
+    EXPECT_EQ(arr->count_if<int>(Compare::Greater, 1), 4);
+    EXPECT_EQ(arr->dot<int>(*seg), 16);
+    EXPECT_EQ(seg->sum<int>(), 16);
+    
+    EXPECT_FALSE(arr->dot<int>(*other).has_value());
+    EXPECT_EQ(manager.program_errors("prog").size(), 1);
+    EXPECT_THROW(arr->sum<double>(), std::runtime_error);
+    
+    arr->prefix_sum<int>();
+    int last = 0;
+    arr->get_value(last, 7);
+    EXPECT_EQ(last, 8);
+    
+    prog->destroy_element("arr");
+    prog->destroy_element("other");
+}
+
+TEST(ArrayKernelsTest, ArraysAreAlignedForTheirElements) {
+    Manager<1024> manager;
+    Program* prog = manager.add_program("prog", "prog.cpp", 1024);
+    prog->allocate_element<VariableDescriptor>("byte", 1);
+    ArrayDescriptor* arr = prog->allocate_element<ArrayDescriptor>("arr", 4 * sizeof(int), sizeof(int));
+    prog->allocate_element<VariableDescriptor>("byte2", 1);
+    SharedSegmentDescriptor* seg = prog->allocate_element<SharedSegmentDescriptor>("seg", 2 * sizeof(double), sizeof(double), prog);
+    ASSERT_NE(arr, nullptr);
+    ASSERT_NE(seg, nullptr);
+    EXPECT_EQ(arr->get_offset() % alignof(int), 0);
+    EXPECT_EQ(seg->get_offset() % alignof(double), 0);
+    ASSERT_TRUE(arr->fill<int>(0, 4, 3));
+    ASSERT_TRUE(seg->fill<double>(0, 2, 0.0));
+    EXPECT_EQ(arr->sum<int>(), 12);
+    EXPECT_TRUE(seg->transform<double>("prog", [](double x){ return x + 1.5; }));
+    EXPECT_EQ(seg->sum<double>(), 3.0);
+    
+    // The padding in front of the blocks stays usable and survives defragmentation.
+    EXPECT_EQ(manager.get_stats().used, 1 + 16 + 1 + 16);
+    prog->destroy_element("byte");
+    manager.defragment_memory();
+    EXPECT_EQ(manager.find_element("prog", "byte2")->get_offset(), 0);
+    EXPECT_EQ(arr->get_offset() % alignof(int), 0);
+    EXPECT_EQ(seg->get_offset() % alignof(double), 0);
+    EXPECT_EQ(manager.get_stats().used, 16 + 1 + 16);
+    EXPECT_EQ(arr->sum<int>(), 12);
+    EXPECT_EQ(seg->sum<double>(), 3.0);
+}
+
+TEST(ArrayKernelsTest, KernelsAcceptAnyOffset) {
+    for(size_t count : {size_t{1001}, 4 * PARALLEL_THRESHOLD + 3}){
+        std::vector<double> values = make_values<double>(count);
+        std::vector<std::byte> bytes(count * sizeof(double) + 1);
+        std::byte* data = bytes.data() + 1;
+        std::memcpy(data, values.data(), count * sizeof(double));
+        EXPECT_EQ(reduce_sum<double>(data, count), reduce_sum(std::span<const double>(values)));
+        EXPECT_EQ(reduce_minmax<double>(data, count), reduce_minmax(std::span<const double>(values)));
+        EXPECT_EQ(reduce_dot<double>(data, data, count), reduce_dot<double>(values, values));
+        inclusive_prefix_sum<double>(data, count);
+        inclusive_prefix_sum(std::span<double>(values));
+        EXPECT_EQ(std::memcmp(data, values.data(), count * sizeof(double)), 0);
+    }
+}
+
+TEST(ArrayKernelsTest, ReductionsOnUnalignedArray) {
+    Manager<1024> manager(std::make_unique<ShiftedBuffer<1024>>());
+    Program* prog = manager.add_program("prog", "prog.cpp", 1024);
+    ArrayDescriptor* arr = prog->allocate_element<ArrayDescriptor>("arr", 8 * sizeof(int), sizeof(int));
+    ArrayDescriptor* other = prog->allocate_element<ArrayDescriptor>("other", 8 * sizeof(int), sizeof(int));
+    ASSERT_NE(arr, nullptr);
+    ASSERT_NE(other, nullptr);
+    ASSERT_NE(reinterpret_cast<uintptr_t>(manager.get_data() + arr->get_offset()) % alignof(int), 0);
+    const int values[] = {5, -3, 8, 0, 2, 2, -7, 1};
+    ASSERT_TRUE(arr->write_range<int>(0, values));
+    ASSERT_TRUE(other->fill<int>(0, 8, 2));
+
+    EXPECT_EQ(arr->sum<int>(), 8);
+    EXPECT_EQ(arr->min<int>(), -7);
+    EXPECT_EQ(arr->max<int>(), 8);
+    EXPECT_EQ(arr->count_if<int>(Compare::Greater, 1), 4);
+    EXPECT_EQ(arr->dot<int>(*other), 16);
+    arr->prefix_sum<int>();
+    int last = 0;
+    arr->get_value(last, 7);
+    EXPECT_EQ(last, 8);
+    EXPECT_THROW(arr->view<int>(), std::runtime_error);
+}
+
+TEST(ArrayKernelsTest, TransformOnUnalignedSegment) {
+    Manager<4096> manager(std::make_unique<ShiftedBuffer<4096>>());
+    Program* prog = manager.add_program("prog", "prog.cpp", 4096);
+    constexpr size_t count = 300;
+    SharedSegmentDescriptor* seg = prog->allocate_element<SharedSegmentDescriptor>("seg", count * sizeof(double), sizeof(double), prog);
+    ASSERT_NE(seg, nullptr);
+    ASSERT_NE(reinterpret_cast<uintptr_t>(manager.get_data() + seg->get_offset()) % alignof(double), 0);
+    ASSERT_TRUE(seg->fill<double>(0, count, 1.0));
+
+    EXPECT_TRUE(seg->transform<double>("prog", [](double x){ return x * 2 + 0.5; }));
+    EXPECT_EQ(seg->sum<double>(), 2.5 * count);
+    double last = 0;
+    seg->get_value(last, count - 1);
+    EXPECT_EQ(last, 2.5);
+    EXPECT_THROW(seg->for_each_chunk<double>("prog", [](std::span<double>){}), std::runtime_error);
+}
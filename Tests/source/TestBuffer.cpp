@@ -85,4 +85,84 @@ TEST(BufferTest, GetBlocks) {
     EXPECT_EQ(blocks.size(), 1);
     EXPECT_EQ(blocks[0].offset, 300);
     EXPECT_EQ(blocks[0].size, 724);
-}
\ No newline at end of file
+}
+
+TEST(BufferTest, TryAllocateReportsOverflow) {
+    Buffer<100> buffer;
+    
+    auto offset = buffer.try_allocate_block(60);
+    ASSERT_TRUE(offset.has_value());
+    EXPECT_EQ(*offset, 0);
+    
+    auto failed = buffer.try_allocate_block(60);
+    ASSERT_FALSE(failed.has_value());
+    EXPECT_EQ(failed.error(), BufferError::Overflow);
+    EXPECT_EQ(buffer.get_blocks().size(), 1);
+}
+
+TEST(BufferTest, TryDestroyReportsErrors) {
+    Buffer<100> buffer;
+    size_t offset = buffer.allocate_block(50);
+    
+    EXPECT_EQ(buffer.try_destroy_block(90, 20).error(), BufferError::OutOfRange);
+    EXPECT_TRUE(buffer.try_destroy_block(offset, 50).has_value());
+    EXPECT_EQ(buffer.try_destroy_block(offset, 50).error(), BufferError::DoubleFree);
+    EXPECT_EQ(describe_buffer_error(BufferError::OutOfRange, 90, 20), "Invalid offset 90 with size 20.");
+}
+
+TEST(BufferTest, TracksFreeBytesAndLargestBlock) {
+    Buffer<100> buffer;
+    EXPECT_EQ(buffer.get_free_memory(), 100);
+    EXPECT_EQ(buffer.get_largest_free_block(), 100);
+    
+    size_t a = buffer.allocate_block(10);
+    size_t b = buffer.allocate_block(30);
+    buffer.allocate_block(20);
+    EXPECT_EQ(buffer.get_free_memory(), 40);
+    EXPECT_EQ(buffer.get_largest_free_block(), 40);
+    
+    buffer.destroy_block(b, 30);
+    buffer.destroy_block(a, 10);
+    EXPECT_EQ(buffer.get_free_memory(), 80);
+    EXPECT_EQ(buffer.get_blocks().size(), 2);
+    EXPECT_EQ(buffer.get_largest_free_block(), 40);
+    
+    buffer.allocate_block(40);
+    EXPECT_EQ(buffer.get_largest_free_block(), 40);
+    buffer.allocate_block(40);
+    EXPECT_EQ(buffer.get_free_memory(), 0);
+    EXPECT_EQ(buffer.get_largest_free_block(), 0);
+    
+    buffer.compact(60);
+    EXPECT_EQ(buffer.get_free_memory(), 40);
+    EXPECT_EQ(buffer.get_largest_free_block(), 40);
+    EXPECT_EQ(buffer.get_blocks().size(), 1);
+}
+
+TEST(BufferTest, AlignedAllocationKeepsPaddingFree) {
+    Buffer<100> buffer;
+    buffer.allocate_block(1);
+    
+    EXPECT_EQ(buffer.allocate_block(8, 8), 8);
+    EXPECT_EQ(buffer.get_free_memory(), 91);
+    ASSERT_EQ(buffer.get_blocks().size(), 2);
+    EXPECT_EQ(buffer.get_blocks()[0].offset, 1);
+    EXPECT_EQ(buffer.get_blocks()[0].size, 7);
+    
+    EXPECT_EQ(buffer.allocate_block(4, 4), 4);
+    EXPECT_EQ(buffer.allocate_block(3), 1);
+    EXPECT_EQ(buffer.get_blocks().size(), 1);
+    EXPECT_EQ(buffer.get_largest_free_block(), 84);
+    EXPECT_EQ(buffer.allocate_block(4), 16);
+    EXPECT_EQ(buffer.try_allocate_block(80, 16).error(), BufferError::Overflow);
+    EXPECT_EQ(buffer.allocate_block(64, 16), 32);
+}
+
+TEST(BufferTest, NaturalAlignment) {
+    EXPECT_EQ(natural_alignment(0), 1);
+    EXPECT_EQ(natural_alignment(1), 1);
+    EXPECT_EQ(natural_alignment(4), 4);
+    EXPECT_EQ(natural_alignment(12), 4);
+    EXPECT_EQ(natural_alignment(8), 8);
+    EXPECT_EQ(natural_alignment(64), alignof(std::max_align_t));
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <Memory/BulkCopy.hpp>
+#include <Memory/Manager.hpp>
+#include <Memory/Program.hpp>
+#include <Memory/ArrayDescriptor.hpp>
+#include <vector>
+#include <cstring>
+
+using namespace MemoryNameSpace;
+
+TEST(BulkCopyTest, CopySmallAndLargeRanges) {
+    for(size_t size : {size_t{0}, size_t{7}, size_t{100}, NON_TEMPORAL_THRESHOLD + 77}){
+        std::vector<std::byte> source(size + 3), destination(size + 3);
+        for(size_t i = 0; i < source.size(); ++i) source[i] = static_cast<std::byte>(i * 31);
+        
+        copy_bytes(destination.data() + 1, source.data() + 2, size);
+        EXPECT_EQ(std::memcmp(destination.data() + 1, source.data() + 2, size), 0);
+        EXPECT_EQ(destination[0], std::byte{0});
+        EXPECT_EQ(destination[size + 1], std::byte{0});
+    }
+}
+
+TEST(BulkCopyTest, FillSmallAndLargeRanges) {
+    const int value = 0x01020304;
+    const std::byte odd[3] = {std::byte{1}, std::byte{2}, std::byte{3}};
+    for(size_t count : {size_t{1}, size_t{33}, NON_TEMPORAL_THRESHOLD / sizeof(int) + 5}){
+        std::vector<std::byte> buffer(count * sizeof(int) + 2);
+        fill_bytes(buffer.data() + 1, count, reinterpret_cast<const std::byte*>(&value), sizeof(int));
+        for(size_t i = 0; i < count; ++i){
+            int stored = 0;
+            std::memcpy(&stored, buffer.data() + 1 + i * sizeof(int), sizeof(int));
+            ASSERT_EQ(stored, value);
+        }
+        EXPECT_EQ(buffer.back(), std::byte{0});
+        
+        std::vector<std::byte> pattern_buffer(count * 3);
+        fill_bytes(pattern_buffer.data(), count, odd, 3);
+        for(size_t i = 0; i < pattern_buffer.size(); ++i)
+            ASSERT_EQ(pattern_buffer[i], odd[i % 3]);
+    }
+}
+
+TEST(BulkCopyTest, LargeArrayRangeRoundTrip) {
+    constexpr size_t capacity = 4 * NON_TEMPORAL_THRESHOLD;
+    Manager<capacity> manager;
+    Program* prog = manager.add_program("prog", "prog.cpp", capacity);
+    const size_t count = 2 * NON_TEMPORAL_THRESHOLD / sizeof(long long);
+    ArrayDescriptor* arr = prog->allocate_element<ArrayDescriptor>("arr", count * sizeof(long long), sizeof(long long));
+    ASSERT_NE(arr, nullptr);
+    
+    std::vector<long long> values(count);
+    for(size_t i = 0; i < count; ++i) values[i] = static_cast<long long>(i) * 3 - 7;
+    EXPECT_TRUE(arr->write_range<long long>(0, values));
+    
+    std::vector<long long> out(count, 0);
+    EXPECT_TRUE(arr->read_range<long long>(0, out));
+    EXPECT_EQ(out, values);
+    
+    EXPECT_TRUE(arr->fill<long long>(1, count, 42));
+    EXPECT_TRUE(arr->read_range<long long>(0, out));
+    EXPECT_EQ(out.front(), -7);
+    EXPECT_EQ(out.back(), 42);
+    prog->destroy_element("arr");
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <Memory/DescriptorPool.hpp>
+#include <Memory/NameArena.hpp>
+#include <Memory/Manager.hpp>
+#include <Memory/Program.hpp>
+#include <Memory/VariableDescriptor.hpp>
+#include <Memory/ArrayDescriptor.hpp>
+#include <memory>
+#include <type_traits>
+
+using namespace MemoryNameSpace;
+
+namespace{
+
+struct Tracked{
+    static inline int alive = 0;
+    int value;
+    explicit Tracked(int v) : value(v) { ++alive; }
+    virtual ~Tracked() { --alive; }
+};
+
+}
+
+TEST(DescriptorPoolTest, CreateAndDestroy) {
+    DescriptorPool pool;
+    
+    Tracked* object = pool.create<Tracked>(5);
+    EXPECT_EQ(object->value, 5);
+    EXPECT_EQ(Tracked::alive, 1);
+    EXPECT_EQ(pool.get_live_objects(), 1);
+    
+    DescriptorPool::destroy(object);
+    EXPECT_EQ(Tracked::alive, 0);
+    EXPECT_EQ(pool.get_live_objects(), 0);
+}
+
+TEST(DescriptorPoolTest, ReusesReleasedChunks) {
+    DescriptorPool pool;
+    
+    Tracked* first = pool.create<Tracked>(1);
+    DescriptorPool::destroy(first);
+    Tracked* second = pool.create<Tracked>(2);
+    EXPECT_EQ(first, second);
+    DescriptorPool::destroy(second);
+}
+
+TEST(DescriptorPoolTest, GrowsBySlabs) {
+    DescriptorPool pool;
+    std::vector<PooledPtr<Tracked>> objects;
+    
+    for(int i = 0; i < 10000; ++i)
+        objects.emplace_back(pool.create<Tracked>(i));
+    EXPECT_EQ(Tracked::alive, 10000);
+    EXPECT_GT(pool.get_reserved_bytes(), DescriptorPool::SLAB_SIZE);
+    
+    size_t reserved = pool.get_reserved_bytes();
+    objects.clear();
+    EXPECT_EQ(Tracked::alive, 0);
+    
+    for(int i = 0; i < 10000; ++i)
+        objects.emplace_back(pool.create<Tracked>(i));
+    EXPECT_EQ(pool.get_reserved_bytes(), reserved);
+}
+
+TEST(NameArenaTest, InternsOnce) {
+    NameArena arena;
+    
+    const InternedName& first = arena.intern("var");
+    const InternedName& second = arena.intern(std::string("var"));
+    EXPECT_EQ(&first, &second);
+    EXPECT_EQ(first.name, "var");
+    EXPECT_EQ(first.hash, hash_name("var"));
+    
+    arena.intern("other");
+    EXPECT_EQ(arena.size(), 2);
+}
+
+TEST(NameArenaTest, ReleasesUnusedNames) {
+    NameArena arena;
+    
+    const InternedName& first = arena.intern("var");
+    arena.intern("var");
+    arena.release(first);
+    EXPECT_EQ(arena.find("var"), &first);
+    arena.release(first);
+    EXPECT_EQ(arena.find("var"), nullptr);
+    EXPECT_EQ(arena.size(), 0);
+    
+    const InternedName& reused = arena.intern("other");
+    EXPECT_EQ(&reused, &first);
+    EXPECT_EQ(reused.name, "other");
+    EXPECT_EQ(arena.find("other"), &reused);
+}
+
+TEST(NameArenaTest, ReusedSlotKeepsCapacity) {
+    NameArena arena;
+    const std::string name(64, 'n');
+    
+    const InternedName& first = arena.intern(name);
+    const char* text = first.name.data();
+    arena.release(first);
+    const InternedName& again = arena.intern(name);
+    EXPECT_EQ(&again, &first);
+    EXPECT_EQ(again.name.data(), text);
+}
+
+TEST(NameArenaTest, ManagerReleasesNamesOfDestroyedElements) {
+    Manager<1024> manager;
+    Program* prog = manager.add_program("prog", "prog.cpp", 1024);
+    
+    for(int i = 0; i < 1000; ++i){
+        std::string name = "var" + std::to_string(i);
+        ASSERT_NE(prog->allocate_element<VariableDescriptor>(name, 4), nullptr);
+        ASSERT_NE(prog->make_reference("ref" + std::to_string(i), name), nullptr);
+        prog->destroy_element("ref" + std::to_string(i));
+        prog->destroy_element(name);
+    }
+    EXPECT_EQ(manager.get_name_count(), 0);
+}
+
+TEST(DescriptorPoolTest, ManagerElementsComeFromPool) {
+    Manager<1024> manager;
+    Program* prog = manager.add_program("prog", "prog.cpp", 1024);
+    
+    for(int round = 0; round < 3; ++round){
+        prog->allocate_element<VariableDescriptor>("var", sizeof(int));
+        prog->allocate_element<ArrayDescriptor>("arr", 4 * sizeof(int), sizeof(int));
+        prog->make_reference("ref", "var");
+        EXPECT_EQ(manager.get_descriptor_pool().get_live_objects(), 3);
+        
+        prog->destroy_element("ref");
+        prog->destroy_element("arr");
+        prog->destroy_element("var");
+        EXPECT_EQ(manager.get_descriptor_pool().get_live_objects(), 0);
+    }
+    EXPECT_EQ(manager.find_element("prog", "var"), nullptr);
+}
+
+TEST(DescriptorPoolTest, DestroyPopulatedManager) {
+    static_assert(!std::is_move_constructible_v<Manager<1024>>);
+    static_assert(!std::is_move_assignable_v<Manager<1024>>);
+    
+    auto manager = std::make_unique<Manager<1024>>();
+    Program* prog = manager->add_program("prog", "prog.cpp", 1024);
+    prog->allocate_element<VariableDescriptor>("var", sizeof(int));
+    prog->make_reference("ref", "var");
+    
+    // Programs see each other's segments and leftovers outlive their program.
+    Program* other = manager->add_program("other", "other.cpp", 1024);
+    other->allocate_element<SharedSegmentDescriptor>("seg", 4 * sizeof(int), sizeof(int), other);
+    EXPECT_TRUE(manager->get_access_to_shared("prog", "seg"));
+    manager->add_program("gone", "gone.cpp", 1024)->allocate_element<VariableDescriptor>("leak", sizeof(int));
+    manager->delete_program("gone");
+    EXPECT_EQ(manager->get_descriptor_pool().get_live_objects(), 4);
+    manager.reset();
+}
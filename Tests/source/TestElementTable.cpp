@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <Memory/ElementTable.hpp>
+#include <Memory/Manager.hpp>
+#include <Memory/Program.hpp>
+#include <Memory/VariableDescriptor.hpp>
+#include <Memory/ArrayDescriptor.hpp>
+#include <Memory/SharedSegmentDescriptor.hpp>
+
+using namespace MemoryNameSpace;
+
+TEST(ElementTableTest, InsertAndErase) {
+    ElementTable table;
+    
+    ElementId a = table.insert(nullptr, ElementKind::Variable, 0, 8, 8);
+    ElementId b = table.insert(nullptr, ElementKind::Array, 8, 32, 4);
+    EXPECT_EQ(table.size(), 2);
+    EXPECT_EQ(table.get_offset(b), 8);
+    EXPECT_EQ(table.get_size(b), 32);
+    EXPECT_EQ(table.get_elem_size(b), 4);
+    EXPECT_EQ(table.get_kind(b), ElementKind::Array);
+    EXPECT_EQ(table.get_owner(a), INVALID_PROGRAM_ID);
+    EXPECT_EQ(table.get_used_memory(), 40);
+    
+    table.erase(a);
+    EXPECT_EQ(table.size(), 1);
+    EXPECT_EQ(table.get_used_memory(), 32);
+    
+    ElementId c = table.insert(nullptr, ElementKind::Variable, 40, 16, 16);
+    EXPECT_EQ(c, a);
+    EXPECT_EQ(table.slot_count(), 2);
+    EXPECT_EQ(table.get_used_memory(), 48);
+}
+
+TEST(ElementTableTest, ManagerKeepsMetadataInTable) {
+    Manager<1024> manager;
+    Program* prog = manager.add_program("prog", "prog.cpp", 1024);
+    const ElementTable& table = manager.get_element_table();
+    
+    VariableDescriptor* var = prog->allocate_element<VariableDescriptor>("var", sizeof(int));
+    ArrayDescriptor* arr = prog->allocate_element<ArrayDescriptor>("arr", 8 * sizeof(int), sizeof(int));
+    ReferenceDescriptor* ref = prog->make_reference("ref", "arr");
+    
+    EXPECT_EQ(table.size(), 2);
+    EXPECT_EQ(ref->get_id(), INVALID_ELEMENT_ID);
+    EXPECT_EQ(table.get_element(arr->get_id()), arr);
+    EXPECT_EQ(table.get_owner(var->get_id()), prog->get_id());
+    EXPECT_EQ(table.get_elem_size(arr->get_id()), sizeof(int));
+    EXPECT_EQ(table.get_used_memory(), 9 * sizeof(int));
+    
+    prog->destroy_element("ref");
+    prog->destroy_element("var");
+    EXPECT_EQ(table.size(), 1);
+    EXPECT_EQ(table.get_used_memory(), 8 * sizeof(int));
+    prog->destroy_element("arr");
+}
+
+TEST(ElementTableTest, StatisticsCountSharedSegmentsForEveryProgram) {
+    Manager<1024> manager;
+    Program* prog1 = manager.add_program("prog1", "prog1.cpp", 1024);
+    Program* prog2 = manager.add_program("prog2", "prog2.cpp", 1024);
+    EXPECT_NE(prog1->get_id(), prog2->get_id());
+    
+    prog1->allocate_element<VariableDescriptor>("var", 64);
+    prog1->allocate_element<SharedSegmentDescriptor>("seg", 128, 8, prog1);
+    ASSERT_TRUE(manager.get_access_to_shared("prog2", "seg"));
+    
+    auto stats = manager.statistics();
+    EXPECT_DOUBLE_EQ(stats["prog1"], static_cast<double>(prog1->get_used_memory()) / 1024);
+    EXPECT_DOUBLE_EQ(stats["prog2"], static_cast<double>(prog2->get_used_memory()) / 1024);
+    EXPECT_DOUBLE_EQ(stats["prog2"], 128.0 / 1024);
+    
+    prog1->destroy_element("var");
+}
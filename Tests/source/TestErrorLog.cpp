@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <Memory/ErrorLog.hpp>
+#include <Memory/Manager.hpp>
+#include <Memory/Program.hpp>
+#include <Memory/VariableDescriptor.hpp>
+
+using namespace MemoryNameSpace;
+
+TEST(ErrorLogTest, FormatsRecordsOnRead) {
+    ErrorLog log;
+    
+    log.record(ErrorCode::RangeOutOfBounds, "prog", ErrorContext{"arr", {}, {2, 5, 4}});
+    log.record(ErrorCode::LengthMismatch, "prog", ErrorContext{"a", "b", {}});
+    log.record_text(ACCESS_ERROR, "custom message", "other");
+    
+    auto errors = log.all();
+    ASSERT_EQ(errors.size(), 3);
+    EXPECT_EQ(errors[0].get_type(), SIZE_ERROR);
+    EXPECT_NE(errors[0].get_description().find("The range [2, 5) is out of bounds of the array 'arr' with 4 elements."), std::string::npos);
+    EXPECT_NE(errors[1].get_description().find("The arrays 'a' and 'b' have different lengths."), std::string::npos);
+    EXPECT_EQ(errors[2].get_type(), ACCESS_ERROR);
+    EXPECT_EQ(errors[2].get_program(), "other");
+    EXPECT_NE(errors[2].get_description().find("custom message"), std::string::npos);
+    EXPECT_LE(errors[0].get_time(), errors[2].get_time());
+}
+
+TEST(ErrorLogTest, IndexesByProgramAndType) {
+    ErrorLog log;
+    
+    log.record(ErrorCode::ElementNotFound, "a", {"x"});
+    log.record(ErrorCode::DoubleFree, "b", {});
+    log.record(ErrorCode::ElementPinned, "a", {"y"});
+    
+    EXPECT_EQ(log.count("a"), 2);
+    EXPECT_EQ(log.count("b"), 1);
+    EXPECT_EQ(log.count("missing"), 0);
+    EXPECT_EQ(log.count(ACCESS_ERROR), 2);
+    EXPECT_EQ(log.count(DOUBLE_FREE), 1);
+    EXPECT_EQ(log.count(SIZE_ERROR), 0);
+    
+    auto errors = log.by_program("a");
+    ASSERT_EQ(errors.size(), 2);
+    EXPECT_NE(errors[0].get_description().find("'x'"), std::string::npos);
+    EXPECT_NE(errors[1].get_description().find("'y'"), std::string::npos);
+    EXPECT_TRUE(log.by_program("missing").empty());
+    EXPECT_EQ(log.by_type(DOUBLE_FREE).front().get_program(), "b");
+}
+
+TEST(ErrorLogTest, RingReplacesOldestRecords) {
+    ErrorLog log(4);
+    
+    for(size_t i = 0; i < 10; ++i)
+        log.record(i % 2 == 0 ? ErrorCode::InvalidBlock : ErrorCode::DoubleFree,
+                   i % 3 == 0 ? "a" : "b", ErrorContext{{}, {}, {i, 1, 0}});
+    
+    EXPECT_EQ(log.size(), 4);
+    EXPECT_EQ(log.dropped(), 6);
+    EXPECT_EQ(log.total(SIZE_ERROR), 5);
+    EXPECT_EQ(log.count(SIZE_ERROR) + log.count(DOUBLE_FREE), 4);
+    EXPECT_EQ(log.count("a") + log.count("b"), 4);
+    
+    auto errors = log.all();
+    ASSERT_EQ(errors.size(), 4);
+    EXPECT_EQ(errors[0].get_description(), log.by_type(SIZE_ERROR)[0].get_description());
+    EXPECT_NE(errors[0].get_description().find("Invalid offset 6 with size 1."), std::string::npos);
+    
+    auto a_errors = log.by_program("a");
+    ASSERT_EQ(a_errors.size(), 2);
+    EXPECT_NE(a_errors[0].get_description().find("Invalid offset 6"), std::string::npos);
+    EXPECT_NE(a_errors[1].get_description().find("Double free."), std::string::npos);
+}
+
+TEST(ErrorLogTest, ManagerKeepsErrorsAfterElementIsGone) {
+    Manager<1024> manager;
+    Program* prog = manager.add_program("prog", "test.cpp", 512);
+    prog->allocate_element<VariableDescriptor>("var", sizeof(int));
+    prog->allocate_element<VariableDescriptor>("var", sizeof(int));
+    prog->destroy_element("var");
+    
+    auto errors = manager.type_errors(MEMORY_LEAK);
+    ASSERT_EQ(errors.size(), 1);
+    EXPECT_NE(errors[0].get_description().find("The memory for variable 'var' has already been allocated."), std::string::npos);
+    EXPECT_EQ(manager.get_error_log().count("prog"), 1);
+}
+
+TEST(ErrorLogTest, CoalescesIdenticalConsecutiveErrors) {
+    ErrorLog log;
+    
+    for(int i = 0; i < 100; ++i)
+        log.record(ErrorCode::ElementNotAvailable, "a", {"x"});
+    log.record(ErrorCode::ElementNotAvailable, "b", {"x"});
+    log.record(ErrorCode::ElementNotAvailable, "a", {"x"});
+    log.record(ErrorCode::ElementNotAvailable, "a", {"y"});
+    log.record(ErrorCode::ElementNotAvailable, "a", {"x"});
+    
+    EXPECT_EQ(log.size(), 4);
+    EXPECT_EQ(log.total(ACCESS_ERROR), 104);
+    
+    auto errors = log.by_program("a");
+    ASSERT_EQ(errors.size(), 3);
+    EXPECT_EQ(errors[0].get_count(), 101);
+    EXPECT_LE(errors[0].get_time(), errors[0].get_last_time());
+    EXPECT_EQ(errors[1].get_count(), 1);
+    EXPECT_EQ(errors[2].get_count(), 1);
+}
+
+TEST(ErrorLogTest, RateLimitSuppressesNewRecords) {
+    ErrorLog log;
+    log.set_rate_limit(ErrorRateLimit{2, std::chrono::hours(1)});
+    log.set_rate_limit("trusted", ErrorRateLimit{});
+    
+    for(size_t i = 0; i < 10; ++i){
+        log.record(ErrorCode::InvalidBlock, "noisy", ErrorContext{{}, {}, {i, 1, 0}});
+        log.record(ErrorCode::InvalidBlock, "trusted", ErrorContext{{}, {}, {i, 1, 0}});
+    }
+    
+    EXPECT_EQ(log.count("noisy"), 2);
+    EXPECT_EQ(log.suppressed("noisy"), 8);
+    EXPECT_EQ(log.count("trusted"), 10);
+    EXPECT_EQ(log.suppressed("trusted"), 0);
+    EXPECT_EQ(log.suppressed(), 8);
+    
+    log.record(ErrorCode::InvalidBlock, "noisy", ErrorContext{{}, {}, {1, 1, 0}});
+    EXPECT_EQ(log.by_program("noisy").back().get_count(), 2);
+    
+    log.set_rate_limit("noisy", ErrorRateLimit{1, std::chrono::nanoseconds(0)});
+    log.record(ErrorCode::DoubleFree, "noisy", {});
+    EXPECT_EQ(log.count("noisy"), 3);
+}
+
+TEST(ErrorLogTest, ReplacedRecordsReleaseTheirNames) {
+    ErrorLog log(4);
+    
+    for(size_t i = 0; i < 1000; ++i)
+        log.record(ErrorCode::LengthMismatch, "prog" + std::to_string(i),
+                   ErrorContext{"a" + std::to_string(i), "b" + std::to_string(i), {}});
+    
+    EXPECT_EQ(log.size(), 4);
+    EXPECT_EQ(log.name_count(), 4 * 3);
+    EXPECT_EQ(log.count("prog0"), 0);
+    EXPECT_EQ(log.count("prog999"), 1);
+    EXPECT_EQ(log.by_program("prog996").front().get_description(), log.all().front().get_description());
+    
+    // A program with its own rate limit keeps its chain without records.
+    log.set_rate_limit("quiet", ErrorRateLimit{1, std::chrono::hours(1)});
+    log.record(ErrorCode::DoubleFree, "quiet", {});
+    log.record(ErrorCode::InvalidBlock, "quiet", ErrorContext{{}, {}, {1, 1, 0}});
+    for(size_t i = 0; i < 4; ++i) log.record(ErrorCode::DoubleFree, "other" + std::to_string(i), {});
+    EXPECT_EQ(log.count("quiet"), 0);
+    EXPECT_EQ(log.suppressed("quiet"), 1);
+    EXPECT_EQ(log.name_count(), 4 + 1);
+}
+
+TEST(ErrorLogTest, RejectsInvalidErrorTypes) {
+    Manager<1024> manager;
+    Program* prog = manager.add_program("prog", "test.cpp", 512);
+    
+    EXPECT_THROW(manager.record_error(ERROR_TYPE_COUNT, "bad type", "prog"), std::out_of_range);
+    EXPECT_THROW(prog->record_error(size_t{1} << 40, "bad type"), std::out_of_range);
+    EXPECT_EQ(manager.get_error_log().size(), 0);
+    
+    prog->record_error(ACCESS_ERROR, "good type");
+    EXPECT_EQ(manager.get_error_log().count(ACCESS_ERROR), 1);
+}
+
+TEST(ErrorLogTest, DefaultRateLimitBoundsEachProgram) {
+    ErrorLog log;
+    const size_t limit = ErrorLog::DEFAULT_RATE_LIMIT.records;
+    ASSERT_GT(limit, 0);
+    ASSERT_LT(limit, log.capacity());
+    
+    for(size_t i = 0; i < log.capacity(); ++i)
+        log.record(ErrorCode::InvalidBlock, "noisy", ErrorContext{{}, {}, {i, 1, 0}});
+    log.record(ErrorCode::DoubleFree, "other", {});
+    
+    EXPECT_EQ(log.count("noisy"), limit);
+    EXPECT_EQ(log.suppressed("noisy"), log.capacity() - limit);
+    EXPECT_EQ(log.count("other"), 1);
+}
+
+TEST(ErrorLogTest, LongTextsAreCut) {
+    ErrorLog log;
+    std::string program(1000, 'p');
+    std::string description(10000, 'd');
+    
+    log.record_text(SIZE_ERROR, description, program);
+    log.record_text(SIZE_ERROR, description + "tail", program + "tail");
+    
+    auto errors = log.by_program(program);
+    ASSERT_EQ(errors.size(), 1);
+    EXPECT_EQ(errors[0].get_count(), 2);
+    EXPECT_EQ(errors[0].get_program(), program.substr(0, ErrorLog::MAX_TEXT_LENGTH));
+    EXPECT_NE(errors[0].get_description().find(description.substr(0, ErrorLog::MAX_TEXT_LENGTH)), std::string::npos);
+    EXPECT_EQ(errors[0].get_description().find(description.substr(0, ErrorLog::MAX_TEXT_LENGTH + 1)), std::string::npos);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <Memory/FlatTable.hpp>
+#include <Memory/NameHash.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <random>
+
+using namespace MemoryNameSpace;
+
+TEST(FlatTableTest, EmptyTable) {
+    FlatTable<int, int> table;
+    
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(table.size(), 0);
+    EXPECT_EQ(table.begin(), table.end());
+    EXPECT_EQ(table.find(1), table.end());
+    EXPECT_EQ(table.erase(1), 0);
+    EXPECT_EQ(table.get_memory_usage(), 0);
+}
+
+TEST(FlatTableTest, InsertFindErase) {
+    FlatTable<int, int> table;
+    
+    auto [it, inserted] = table.try_emplace(1, 10);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it->first, 1);
+    EXPECT_EQ(it->second, 10);
+    
+    auto [it2, inserted2] = table.try_emplace(1, 20);
+    EXPECT_FALSE(inserted2);
+    EXPECT_EQ(it2->second, 10);
+    
+    EXPECT_EQ(table.size(), 1);
+    EXPECT_TRUE(table.contains(1));
+    EXPECT_EQ(table.erase(1), 1);
+    EXPECT_FALSE(table.contains(1));
+    EXPECT_TRUE(table.empty());
+}
+
+TEST(FlatTableTest, GrowthKeepsAllElements) {
+    FlatTable<size_t, size_t> table;
+    const size_t count = 10000;
+    
+    for(size_t i = 0; i < count; ++i)
+        table.try_emplace(i, i * 2);
+    
+    EXPECT_EQ(table.size(), count);
+    for(size_t i = 0; i < count; ++i){
+        auto it = table.find(i);
+        ASSERT_NE(it, table.end());
+        EXPECT_EQ(it->second, i * 2);
+    }
+    EXPECT_EQ(table.find(count), table.end());
+    
+    size_t visited = 0;
+    for(auto&& [key, value] : table){
+        EXPECT_EQ(value, key * 2);
+        ++visited;
+    }
+    EXPECT_EQ(visited, count);
+}
+
+TEST(FlatTableTest, MatchesUnorderedMapUnderChurn) {
+    FlatTable<int, int> table;
+    std::unordered_map<int, int> reference;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> key_dist(0, 500);
+    
+    for(int i = 0; i < 20000; ++i){
+        int key = key_dist(gen);
+        if(gen() % 2){
+            bool inserted = table.try_emplace(key, i).second;
+            EXPECT_EQ(inserted, reference.try_emplace(key, i).second);
+        }
+        else{
+            EXPECT_EQ(table.erase(key), reference.erase(key));
+        }
+    }
+    
+    ASSERT_EQ(table.size(), reference.size());
+    for(auto&& [key, value] : reference){
+        auto it = table.find(key);
+        ASSERT_NE(it, table.end());
+        EXPECT_EQ(it->second, value);
+    }
+}
+
+TEST(FlatTableTest, EraseDuringIteration) {
+    FlatTable<int, int> table;
+    for(int i = 0; i < 100; ++i)
+        table.try_emplace(i, i);
+    
+    for(auto it = table.begin(); it != table.end();){
+        if(it->first % 2) it = table.erase(it);
+        else ++it;
+    }
+    
+    EXPECT_EQ(table.size(), 50);
+    for(auto&& [key, value] : table)
+        EXPECT_EQ(key % 2, 0);
+}
+
+TEST(FlatTableTest, CopyAndMove) {
+    FlatTable<std::string, int> table;
+    table.try_emplace("a", 1);
+    table.try_emplace("b", 2);
+    
+    FlatTable<std::string, int> copy = table;
+    EXPECT_EQ(copy.size(), 2);
+    EXPECT_EQ(copy.find("a")->second, 1);
+    
+    FlatTable<std::string, int> moved = std::move(table);
+    EXPECT_EQ(moved.size(), 2);
+    EXPECT_EQ(moved.find("b")->second, 2);
+    
+    copy = moved;
+    EXPECT_EQ(copy.size(), 2);
+}
+
+TEST(FlatTableTest, MoveOnlyValues) {
+    FlatTable<int, std::unique_ptr<int>> table;
+    for(int i = 0; i < 100; ++i)
+        table.try_emplace(i, std::make_unique<int>(i));
+    
+    EXPECT_EQ(*table.find(42)->second, 42);
+    table.clear();
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(table.find(42), table.end());
+}
+
+TEST(FlatTableTest, HeterogeneousNameLookup) {
+    NameMap<int> table;
+    table.try_emplace_hashed(hash_name("var"), "var", 7);
+    
+    EXPECT_NE(table.find("var"), table.end());
+    EXPECT_NE(table.find(std::string_view{"var"}), table.end());
+    EXPECT_NE(table.find(std::string{"var"}), table.end());
+    EXPECT_NE(table.find(HashedName{"var", hash_name("var")}), table.end());
+    EXPECT_EQ(table.find("other"), table.end());
+}
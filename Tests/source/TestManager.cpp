@@ -3,18 +3,15 @@
 #include <Memory/Program.hpp>
 #include <Memory/VariableDescriptor.hpp>
 #include <Memory/ArrayDescriptor.hpp>
+#include <Memory/SharedSegmentDescriptor.hpp>
 #include <type_traits>
+#include <algorithm>
 
 using namespace MemoryNameSpace;
 
 class ManagerTest : public ::testing::Test {
 protected:
     Manager<1024> manager;
-    
-    void SetUp() override {
-        // Clear any previous state
-        manager = Manager<1024>();
-    }
 };
 
 TEST_F(ManagerTest, AddAndDeleteProgram) {
@@ -124,6 +121,23 @@ TEST_F(ManagerTest, DanglingReferenceDetection) {
     EXPECT_FALSE(dangling[0]->is_valid());
 }
 
+TEST_F(ManagerTest, DanglingReferenceRemovedWithReference) {
+    Program* prog = manager.add_program("prog1", "test.cpp", 512);
+    
+    prog->allocate_element<VariableDescriptor>("myVar", sizeof(int));
+    prog->make_reference("ref1", "myVar");
+    prog->make_reference("ref2", "myVar");
+    
+    prog->destroy_element("myVar");
+    EXPECT_EQ(manager.dungling_reference().size(), 2);
+    
+    // Destroying a dangling reference removes it from the report
+    EXPECT_TRUE(prog->destroy_element("ref1"));
+    auto dangling = manager.dungling_reference();
+    ASSERT_EQ(dangling.size(), 1);
+    EXPECT_EQ(dangling[0]->get_name(), "ref2");
+}
+
 TEST_F(ManagerTest, AccessToSharedSegment) {
     Program* prog1 = manager.add_program("prog1", "test1.cpp", 512);
     Program* prog2 = manager.add_program("prog2", "test2.cpp", 512);
@@ -215,4 +229,212 @@ TEST_F(ManagerTest, ErrorRecording) {
     for (const auto& error : progErrors) {
         EXPECT_EQ(error.get_program(), "prog1");
     }
-}
\ No newline at end of file
+}
+
+TEST_F(ManagerTest, DefragmentationSkipsReferences) {
+    Program* prog = manager.add_program("prog1", "test.cpp", 1024);
+
+    prog->allocate_element<VariableDescriptor>("a", 100);
+    VariableDescriptor* b = prog->allocate_element<VariableDescriptor>("b", sizeof(long));
+    long value = 77;
+    b->set_value(value);
+    ASSERT_NE(prog->make_reference("ref", "b"), nullptr);
+
+    prog->destroy_element("a");
+    manager.defragment_memory();
+
+    long out = 0;
+    b->get_value(out);
+    EXPECT_EQ(b->get_offset(), 0);
+    EXPECT_EQ(out, value);
+
+    VariableDescriptor* c = prog->allocate_element<VariableDescriptor>("c", sizeof(long));
+    ASSERT_NE(c, nullptr);
+    EXPECT_EQ(c->get_offset(), b->get_size());
+}
+
+TEST_F(ManagerTest, FindAndVisitWithoutCopies) {
+    Program* prog1 = manager.add_program("prog1", "test.cpp", 512);
+    Program* prog2 = manager.add_program("prog2", "test.cpp", 512);
+    prog1->allocate_element<VariableDescriptor>("var", sizeof(int));
+    prog2->allocate_element<ArrayDescriptor>("arr", 4 * sizeof(int), sizeof(int));
+    
+    EXPECT_EQ(manager.find_program("prog2"), prog2);
+    EXPECT_EQ(manager.find_program("missing"), nullptr);
+    EXPECT_EQ(manager.find_element("prog2", "arr")->get_kind(), ElementKind::Array);
+    EXPECT_EQ(manager.find_element("missing"), nullptr);
+    EXPECT_EQ(manager.program_count(), 2);
+    EXPECT_EQ(manager.element_count(), 2);
+    
+    std::vector<std::string> programs;
+    manager.for_each_program([&programs](Program& program){ programs.push_back(program.get_name()); });
+    std::sort(programs.begin(), programs.end());
+    EXPECT_EQ(programs, (std::vector<std::string>{"prog1", "prog2"}));
+    
+    size_t bytes = 0;
+    manager.for_each_element([&bytes](IMemoryElement& element){ bytes += element.get_size(); });
+    EXPECT_EQ(bytes, 5 * sizeof(int));
+}
+
+TEST_F(ManagerTest, ProgramsHaveSeparateNamespaces) {
+    Program* prog1 = manager.add_program("prog1", "test.cpp", 512);
+    Program* prog2 = manager.add_program("prog2", "test.cpp", 512);
+    
+    VariableDescriptor* x1 = prog1->allocate_element<VariableDescriptor>("x", sizeof(int));
+    VariableDescriptor* x2 = prog2->allocate_element<VariableDescriptor>("x", sizeof(double));
+    ASSERT_NE(x1, nullptr);
+    ASSERT_NE(x2, nullptr);
+    EXPECT_NE(x1, x2);
+    EXPECT_EQ(manager.element_count(), 2);
+    EXPECT_EQ(manager.find_element("prog1", "x"), x1);
+    EXPECT_EQ(manager.find_element("prog2", "x"), x2);
+    EXPECT_EQ(manager.find_element("x"), nullptr);
+    EXPECT_EQ(prog2->allocate_element<VariableDescriptor>("x", sizeof(int)), nullptr);
+    
+    EXPECT_TRUE(prog1->destroy_element("x"));
+    EXPECT_EQ(manager.find_element("prog1", "x"), nullptr);
+    EXPECT_EQ(manager.find_element("prog2", "x"), x2);
+    EXPECT_TRUE(prog2->destroy_element("x"));
+    EXPECT_EQ(manager.element_count(), 0);
+}
+
+TEST_F(ManagerTest, SegmentDirectory) {
+    Program* prog1 = manager.add_program("prog1", "test.cpp", 512);
+    Program* prog2 = manager.add_program("prog2", "test.cpp", 512);
+    
+    auto* segment = prog1->allocate_element<SharedSegmentDescriptor>("seg", 4 * sizeof(int), sizeof(int), prog1);
+    ASSERT_NE(segment, nullptr);
+    EXPECT_EQ(prog2->allocate_element<SharedSegmentDescriptor>("seg", sizeof(int), sizeof(int), prog2), nullptr);
+    
+    // A private name may shadow a segment the program has no access to, but then blocks access to it.
+    ASSERT_NE(prog2->allocate_element<VariableDescriptor>("seg", sizeof(int)), nullptr);
+    EXPECT_EQ(manager.find_element("seg"), segment);
+    EXPECT_FALSE(manager.get_access_to_shared("prog2", "seg"));
+    EXPECT_TRUE(prog2->destroy_element("seg"));
+    
+    EXPECT_TRUE(manager.get_access_to_shared("prog2", "seg"));
+    EXPECT_EQ(manager.find_element("prog2", "seg"), segment);
+    EXPECT_TRUE(manager.revoke_access_to_shared("prog1", "seg"));
+    EXPECT_TRUE(prog2->destroy_element("seg"));
+    EXPECT_EQ(manager.find_element("seg"), nullptr);
+    EXPECT_EQ(manager.element_count(), 0);
+}
+
+TEST_F(ManagerTest, ProgramIdsAreDenseAndReused) {
+    Program* prog1 = manager.add_program("prog1", "test.cpp", 512);
+    Program* prog2 = manager.add_program("prog2", "test.cpp", 512);
+    Program* prog3 = manager.add_program("prog3", "test.cpp", 512);
+    EXPECT_EQ(prog1->get_id(), 0);
+    EXPECT_EQ(prog2->get_id(), 1);
+    EXPECT_EQ(prog3->get_id(), 2);
+    EXPECT_EQ(manager.find_program(ProgramId{1}), prog2);
+    
+    manager.delete_program("prog2");
+    EXPECT_EQ(manager.find_program(ProgramId{1}), nullptr);
+    EXPECT_EQ(manager.find_program("prog2"), nullptr);
+    EXPECT_EQ(manager.program_count(), 2);
+    
+    Program* prog4 = manager.add_program("prog4", "test.cpp", 512);
+    EXPECT_EQ(prog4->get_id(), 1);
+    EXPECT_EQ(manager.find_program(ProgramId{1}), prog4);
+    EXPECT_EQ(manager.find_program("prog4"), prog4);
+    EXPECT_EQ(manager.statistics().size(), 3);
+}
+
+TEST_F(ManagerTest, LeakedElementsRetireProgramId) {
+    Program* prog1 = manager.add_program("prog1", "test.cpp", 512);
+    ASSERT_NE(prog1->allocate_element<VariableDescriptor>("x", sizeof(int)), nullptr);
+    manager.delete_program("prog1");
+    
+    // The leaked 'x' is still keyed by id 0, so the next program gets a new id.
+    Program* prog2 = manager.add_program("prog2", "test.cpp", 512);
+    EXPECT_EQ(prog2->get_id(), 1);
+    EXPECT_EQ(manager.element_count(), 1);
+    EXPECT_NE(prog2->allocate_element<VariableDescriptor>("x", sizeof(int)), nullptr);
+    EXPECT_EQ(manager.statistics().at("prog2"), static_cast<double>(sizeof(int)) / 1024);
+}
+
+TEST_F(ManagerTest, ProgramsOwnTheirElements) {
+    Program* prog1 = manager.add_program("prog1", "test.cpp", 512);
+    Program* prog2 = manager.add_program("prog2", "test.cpp", 512);
+    ASSERT_NE(prog1->allocate_element<VariableDescriptor>("x", sizeof(int)), nullptr);
+    auto* segment = prog1->allocate_element<SharedSegmentDescriptor>("seg", 4 * sizeof(int), sizeof(int), prog1);
+    ASSERT_NE(prog1->make_reference("ref", "x"), nullptr);
+    ASSERT_TRUE(manager.get_access_to_shared("prog2", "seg"));
+    EXPECT_EQ(prog1->get_owned_elements().size(), 3);
+    EXPECT_TRUE(prog2->get_owned_elements().empty());
+    EXPECT_EQ(prog2->find_element("seg"), segment);
+    EXPECT_EQ(manager.element_count(), 3);
+    
+    // An owner that revoked its own access still holds the segment and its name.
+    EXPECT_TRUE(manager.revoke_access_to_shared("prog1", "seg"));
+    EXPECT_EQ(prog1->find_element("seg"), nullptr);
+    EXPECT_EQ(prog1->find_owned_element("seg"), segment);
+    EXPECT_EQ(prog1->allocate_element<VariableDescriptor>("seg", sizeof(int)), nullptr);
+    EXPECT_TRUE(prog2->destroy_element("seg"));
+    EXPECT_EQ(prog1->find_owned_element("seg"), nullptr);
+    EXPECT_EQ(manager.element_count(), 2);
+    
+    EXPECT_TRUE(prog1->destroy_element("ref"));
+    EXPECT_TRUE(prog1->destroy_element("x"));
+    EXPECT_TRUE(prog1->get_owned_elements().empty());
+    EXPECT_EQ(manager.element_count(), 0);
+}
+
+TEST_F(ManagerTest, RetiredProgramIdIsReleasedWithLastElement) {
+    Program* prog1 = manager.add_program("prog1", "test.cpp", 512);
+    Program* prog2 = manager.add_program("prog2", "test.cpp", 512);
+    ASSERT_NE(prog1->allocate_element<SharedSegmentDescriptor>("seg", 64, sizeof(int), prog1), nullptr);
+    ASSERT_TRUE(manager.get_access_to_shared("prog2", "seg"));
+    manager.delete_program("prog1");
+    
+    // The segment is still keyed by id 0, so the id stays retired.
+    Program* prog3 = manager.add_program("prog3", "test.cpp", 512);
+    EXPECT_EQ(prog3->get_id(), 2);
+    
+    EXPECT_TRUE(prog2->destroy_element("seg"));
+    Program* prog4 = manager.add_program("prog4", "test.cpp", 512);
+    EXPECT_EQ(prog4->get_id(), 0);
+    EXPECT_EQ(manager.find_program(ProgramId{0}), prog4);
+}
+
+TEST_F(ManagerTest, StatsSnapshotIsMaintainedIncrementally) {
+    Program* prog1 = manager.add_program("prog1", "test.cpp", 512);
+    Program* prog2 = manager.add_program("prog2", "test.cpp", 512);
+    
+    ASSERT_NE(prog1->allocate_element<VariableDescriptor>("a", 100), nullptr);
+    ASSERT_NE(prog1->allocate_element<VariableDescriptor>("b", 100), nullptr);
+    ASSERT_NE(prog1->allocate_element<SharedSegmentDescriptor>("seg", 64, sizeof(int), prog1), nullptr);
+    ASSERT_NE(prog2->allocate_element<VariableDescriptor>("c", 50), nullptr);
+    EXPECT_TRUE(manager.get_access_to_shared("prog2", "seg"));
+    
+    MemoryStats stats = manager.get_stats();
+    EXPECT_EQ(stats.used, 314);
+    EXPECT_EQ(stats.free, 1024 - 314);
+    EXPECT_EQ(stats.free_blocks, 1);
+    EXPECT_DOUBLE_EQ(stats.fragmentation(), 0.0);
+    EXPECT_EQ(stats.usage(prog1->get_id()), 264);
+    EXPECT_EQ(stats.usage(prog2->get_id()), 114);
+    
+    EXPECT_TRUE(prog1->destroy_element("a"));
+    EXPECT_TRUE(manager.revoke_access_to_shared("prog2", "seg"));
+    stats = manager.get_stats();
+    EXPECT_EQ(stats.free, 1024 - 214);
+    EXPECT_EQ(stats.free_blocks, 2);
+    EXPECT_EQ(stats.largest_free_block, 1024 - 314);
+    EXPECT_DOUBLE_EQ(stats.fragmentation(), 1.0 - static_cast<double>(1024 - 314) / (1024 - 214));
+    EXPECT_EQ(stats.usage(prog1->get_id()), 164);
+    EXPECT_EQ(stats.usage(prog2->get_id()), 50);
+    EXPECT_DOUBLE_EQ(manager.statistics().at("prog1"), 164.0 / 1024);
+    
+    manager.defragment_memory();
+    stats = manager.get_stats();
+    EXPECT_EQ(stats.free_blocks, 1);
+    EXPECT_EQ(stats.largest_free_block, 1024 - 214);
+    EXPECT_DOUBLE_EQ(stats.fragmentation(), 0.0);
+    
+    EXPECT_TRUE(prog1->destroy_element("seg"));
+    EXPECT_EQ(manager.get_stats().usage(prog1->get_id()), 100);
+    manager.delete_program("prog2");
+    EXPECT_EQ(manager.get_stats().usage(1), 0);
+}
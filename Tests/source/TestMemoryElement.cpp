@@ -2,8 +2,11 @@
 #include <Memory/VariableDescriptor.hpp>
 #include <Memory/ArrayDescriptor.hpp>
 #include <Memory/ReferenceDescriptor.hpp>
+#include <Memory/ElementVisitor.hpp>
 #include <Memory/Manager.hpp>
 #include <Memory/Program.hpp>
+#include <numeric>
+#include <cstddef>
 
 using namespace MemoryNameSpace;
 
@@ -13,7 +16,6 @@ protected:
     Program* program;
     
     void SetUp() override {
-        manager = Manager<1024>();
         program = manager.add_program("test", "test.cpp", 512);
     }
 };
@@ -93,6 +95,29 @@ TEST_F(MemoryElementsTest, ReferenceToDestroyedElement) {
     EXPECT_EQ(ref->get_offset(), manager.get_capacity());
 }
 
+TEST_F(MemoryElementsTest, ReferenceStaysDanglingAfterNameReuse) {
+    program->allocate_element<VariableDescriptor>("temp", sizeof(int));
+    ReferenceDescriptor* ref = program->make_reference("refToTemp", "temp");
+    
+    program->destroy_element("temp");
+    VariableDescriptor* reused = program->allocate_element<VariableDescriptor>("temp", sizeof(int));
+    ASSERT_NE(reused, nullptr);
+    
+    // Reference was bound to the destroyed element, not to the name
+    EXPECT_FALSE(ref->is_valid());
+    EXPECT_EQ(ref->get_target(), nullptr);
+}
+
+TEST_F(MemoryElementsTest, DestroyReferenceBeforeTarget) {
+    VariableDescriptor* var = program->allocate_element<VariableDescriptor>("target", sizeof(int));
+    ReferenceDescriptor* ref = program->make_reference("ref", "target");
+    EXPECT_EQ(ref->get_target(), var);
+    
+    EXPECT_TRUE(program->destroy_element("ref"));
+    EXPECT_TRUE(program->destroy_element("target"));
+    EXPECT_TRUE(manager.dungling_reference().empty());
+}
+
 TEST_F(MemoryElementsTest, RawValueAccess) {
     VariableDescriptor* var = program->allocate_element<VariableDescriptor>("rawTest", sizeof(double));
     
@@ -126,4 +151,197 @@ TEST_F(MemoryElementsTest, OffsetManagement) {
     var->set_offset(originalOffset + 50);
     
     EXPECT_EQ(var->get_offset(), originalOffset + 50);
-}
\ No newline at end of file
+}
+
+TEST_F(MemoryElementsTest, ElementKindAndCast) {
+    VariableDescriptor* var = program->allocate_element<VariableDescriptor>("var", sizeof(int));
+    ArrayDescriptor* arr = program->allocate_element<ArrayDescriptor>("arr", 4 * sizeof(int), sizeof(int));
+    SharedSegmentDescriptor* seg = program->allocate_element<SharedSegmentDescriptor>("seg", 4 * sizeof(int), sizeof(int), program);
+    ReferenceDescriptor* ref = program->make_reference("ref", "var");
+    ASSERT_NE(ref, nullptr);
+
+    EXPECT_EQ(var->get_kind(), ElementKind::Variable);
+    EXPECT_EQ(arr->get_kind(), ElementKind::Array);
+    EXPECT_EQ(seg->get_kind(), ElementKind::Shared);
+    EXPECT_EQ(ref->get_kind(), ElementKind::Reference);
+
+    IMemoryElement* base = seg;
+    EXPECT_EQ(element_cast<SharedSegmentDescriptor>(base), seg);
+    EXPECT_EQ(element_cast<ArrayDescriptor>(base), seg);
+    EXPECT_EQ(element_cast<MemoryElement>(base), seg);
+    EXPECT_EQ(element_cast<VariableDescriptor>(base), nullptr);
+
+    base = arr;
+    EXPECT_EQ(element_cast<ArrayDescriptor>(base), arr);
+    EXPECT_EQ(element_cast<SharedSegmentDescriptor>(base), nullptr);
+
+    base = ref;
+    EXPECT_EQ(element_cast<ReferenceDescriptor>(base), ref);
+    EXPECT_EQ(element_cast<MemoryElement>(base), nullptr);
+    EXPECT_EQ(element_cast<VariableDescriptor>(static_cast<IMemoryElement*>(nullptr)), nullptr);
+
+    program->destroy_element("ref");
+    program->destroy_element("arr");
+    program->destroy_element("var");
+}
+
+TEST_F(MemoryElementsTest, VisitElementDispatchesOnKind) {
+    VariableDescriptor* var = program->allocate_element<VariableDescriptor>("var", sizeof(int));
+    ArrayDescriptor* arr = program->allocate_element<ArrayDescriptor>("arr", 4 * sizeof(int), sizeof(int));
+    ReferenceDescriptor* ref = program->make_reference("ref", "arr");
+    ASSERT_NE(ref, nullptr);
+
+    auto visitor = Overloaded{
+        [](const VariableDescriptor&){ return 1; },
+        [](const ArrayDescriptor&){ return 2; },
+        [](const SharedSegmentDescriptor&){ return 3; },
+        [](const ReferenceDescriptor&){ return 4; }
+    };
+    EXPECT_EQ(visit_element(*var, visitor), 1);
+    EXPECT_EQ(visit_element(*arr, visitor), 2);
+    EXPECT_EQ(visit_element(*ref, visitor), 4);
+
+    program->destroy_element("ref");
+    program->destroy_element("arr");
+    program->destroy_element("var");
+}
+
+TEST_F(MemoryElementsTest, ArrayViewAccessesDataInPlace) {
+    ArrayDescriptor* arr = program->allocate_element<ArrayDescriptor>("arr", 8 * sizeof(int), sizeof(int));
+    {
+        PinnedSpan<int> view = arr->view<int>();
+        ASSERT_EQ(view.size(), 8);
+        std::iota(view.begin(), view.end(), 1);
+    }
+    
+    int value = 0;
+    arr->get_value(value, 3);
+    EXPECT_EQ(value, 4);
+    
+    const ArrayDescriptor* carr = arr;
+    PinnedSpan<const int> cview = carr->view<int>();
+    EXPECT_EQ(std::accumulate(cview.begin(), cview.end(), 0), 36);
+    EXPECT_THROW(arr->view<char>(), std::runtime_error);
+}
+
+TEST_F(MemoryElementsTest, ViewPinsElement) {
+    program->allocate_element<VariableDescriptor>("gap", 16);
+    ArrayDescriptor* arr = program->allocate_element<ArrayDescriptor>("arr", 4 * sizeof(int), sizeof(int));
+    program->destroy_element("gap");
+    size_t offset = arr->get_offset();
+    
+    PinnedSpan<int> view = arr->view<int>();
+    manager.defragment_memory();
+    EXPECT_EQ(arr->get_offset(), offset);
+    EXPECT_FALSE(program->destroy_element("arr"));
+    EXPECT_NE(manager.find_element(program->get_name(), "arr"), nullptr);
+    
+    PinnedSpan<int> moved = std::move(view);
+    EXPECT_TRUE(view.empty());
+    moved.release();
+    EXPECT_EQ(manager.get_element_table().get_pin_count(), 0);
+    
+    manager.defragment_memory();
+    EXPECT_EQ(arr->get_offset(), 0);
+    EXPECT_TRUE(program->destroy_element("arr"));
+}
+
+TEST_F(MemoryElementsTest, ArrayRangeAccess) {
+    ArrayDescriptor* arr = program->allocate_element<ArrayDescriptor>("arr", 6 * sizeof(int), sizeof(int));
+    const int values[] = {1, 2, 3, 4};
+    
+    EXPECT_TRUE(arr->write_range<int>(1, values));
+    EXPECT_TRUE(arr->fill<int>(5, 6, 9));
+    EXPECT_TRUE(arr->fill<int>(0, 1, -1));
+    
+    int out[6] = {};
+    EXPECT_TRUE(arr->read_range<int>(0, out));
+    EXPECT_EQ(out[0], -1);
+    EXPECT_EQ(out[1], 1);
+    EXPECT_EQ(out[4], 4);
+    EXPECT_EQ(out[5], 9);
+    
+    int partial[2] = {};
+    EXPECT_TRUE(arr->read_range<int>(2, std::span<int>(partial)));
+    EXPECT_EQ(partial[0], 2);
+    EXPECT_EQ(partial[1], 3);
+}
+
+TEST_F(MemoryElementsTest, ArrayRangeOutOfBounds) {
+    ArrayDescriptor* arr = program->allocate_element<ArrayDescriptor>("arr", 4 * sizeof(int), sizeof(int));
+    int out[3] = {};
+    size_t errors = manager.all_errors().size();
+    
+    EXPECT_FALSE(arr->read_range<int>(2, out));
+    EXPECT_FALSE(arr->write_range<int>(5, std::span<const int>()));
+    EXPECT_FALSE(arr->fill<int>(3, 2, 0));
+    EXPECT_FALSE(arr->fill<int>(0, 5, 0));
+    EXPECT_EQ(manager.all_errors().size(), errors + 4);
+    EXPECT_NE(manager.all_errors().back().get_description().find("out of bounds"), std::string::npos);
+    EXPECT_EQ(manager.all_errors().back().get_program(), "test");
+    EXPECT_EQ(manager.program_errors("test").size(), 4);
+    
+    EXPECT_THROW(arr->read_range<double>(0, std::span<double>()), std::runtime_error);
+}
+
+struct Record {
+    int id;
+    double weight;
+    char tag[240];
+};
+
+TEST_F(MemoryElementsTest, VariablePartialRawAccess) {
+    VariableDescriptor* var = program->allocate_element<VariableDescriptor>("rec", sizeof(Record));
+    Record record{};
+    record.id = 1;
+    record.weight = 2.5;
+    var->set_value(record);
+    
+    int id = 42;
+    var->set_raw_value(reinterpret_cast<const std::byte*>(&id), offsetof(Record, id), offsetof(Record, id) + sizeof(int));
+    double weight = 0;
+    var->get_raw_value(reinterpret_cast<std::byte*>(&weight), offsetof(Record, weight), offsetof(Record, weight) + sizeof(double));
+    EXPECT_EQ(weight, 2.5);
+    var->get_value(record);
+    EXPECT_EQ(record.id, 42);
+    
+    EXPECT_THROW(var->get_raw_value(reinterpret_cast<std::byte*>(&weight), 0, sizeof(Record) + 1), std::runtime_error);
+    EXPECT_THROW(var->set_raw_value(reinterpret_cast<const std::byte*>(&id), 8, 4), std::runtime_error);
+}
+
+TEST_F(MemoryElementsTest, VariableFieldAccess) {
+    VariableDescriptor* var = program->allocate_element<VariableDescriptor>("rec", sizeof(Record));
+    var->set_value(Record{});
+    
+    EXPECT_TRUE(var->set_field<double>(offsetof(Record, weight), 7.5));
+    EXPECT_EQ(var->get_field<double>(offsetof(Record, weight)), 7.5);
+    Record record;
+    var->get_value(record);
+    EXPECT_EQ(record.weight, 7.5);
+    
+    var->set_member(&Record::id, 9);
+    EXPECT_EQ(var->get_member(&Record::id), 9);
+    EXPECT_EQ(var->get_field<int>(offsetof(Record, id)), 9);
+    EXPECT_EQ(var->get_member(&Record::weight), 7.5);
+    
+    std::byte tag[2] = {std::byte{'o'}, std::byte{'k'}};
+    EXPECT_TRUE(var->write_bytes(offsetof(Record, tag), tag));
+    var->get_value(record);
+    EXPECT_EQ(record.tag[1], 'k');
+    
+    VariableDescriptor* small = program->allocate_element<VariableDescriptor>("small", sizeof(int));
+    EXPECT_THROW(small->get_member(&Record::id), std::runtime_error);
+}
+
+TEST_F(MemoryElementsTest, VariableFieldOutOfBounds) {
+    VariableDescriptor* var = program->allocate_element<VariableDescriptor>("var", sizeof(int));
+    size_t errors = manager.all_errors().size();
+    
+    EXPECT_FALSE(var->get_field<double>(0).has_value());
+    EXPECT_FALSE(var->set_field<int>(1, 0));
+    std::byte out[1];
+    EXPECT_FALSE(var->read_bytes(5, out));
+    EXPECT_EQ(manager.all_errors().size(), errors + 3);
+    EXPECT_NE(manager.all_errors().back().get_description().find("out of bounds"), std::string::npos);
+    EXPECT_EQ(manager.program_errors("test").size(), 3);
+}
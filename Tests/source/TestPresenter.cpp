@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <MVP/Presenter.hpp>
+#include <Memory/Manager.hpp>
+
+using namespace MemoryNameSpace;
+using namespace MVPNameSpace;
+
+class PresenterTest : public ::testing::Test {
+protected:
+    Manager<1024> manager;
+    Presenter presenter{manager};
+
+    void SetUp() override {
+        presenter.add_program("p1", "test.cpp", 1024);
+        presenter.add_program("p2", "test.cpp", 1024);
+    }
+};
+
+TEST_F(PresenterTest, SameNameInTwoPrograms) {
+    ASSERT_TRUE(presenter.allocate_variable<int>("p1", "x", DataType::Int));
+    ASSERT_TRUE(presenter.allocate_variable<double>("p2", "x", DataType::Double));
+    EXPECT_EQ(presenter.get_type("p1", "x"), DataType::Int);
+    EXPECT_EQ(presenter.get_type("p2", "x"), DataType::Double);
+
+    EXPECT_TRUE(presenter.set_value("p1", "x", 7));
+    EXPECT_TRUE(presenter.set_value("p2", "x", 2.5));
+    EXPECT_EQ(presenter.get_value("p1", "x"), "7");
+    EXPECT_EQ(presenter.get_value("p2", "x"), std::to_string(2.5));
+
+    EXPECT_TRUE(presenter.delete_element("x", "p1"));
+    EXPECT_EQ(presenter.get_type("p1", "x"), DataType::Unknown);
+    EXPECT_EQ(presenter.get_type("p2", "x"), DataType::Double);
+    EXPECT_EQ(presenter.get_value("p2", "x"), std::to_string(2.5));
+    EXPECT_FALSE(presenter.set_value("p1", "x", 1));
+}
+
+TEST_F(PresenterTest, ReferencesAndSegmentsUseOwnerType) {
+    ASSERT_TRUE(presenter.allocate_array<int>("p1", "arr", 4, DataType::Int));
+    ASSERT_TRUE(presenter.allocate_shared<long long>("p1", "seg", 2, DataType::LongLong));
+    ASSERT_TRUE(presenter.make_reference("ref", "arr", "p1"));
+    ASSERT_TRUE(presenter.request_access("seg", "p2"));
+
+    EXPECT_EQ(presenter.get_type("p1", "ref"), DataType::Int);
+    EXPECT_TRUE(presenter.is_array("p1", "arr"));
+    EXPECT_FALSE(presenter.is_array("p2", "arr"));
+    EXPECT_EQ(presenter.get_type("p2", "seg"), DataType::LongLong);
+    EXPECT_TRUE(presenter.set_value("p2", "seg", 42LL, 1));
+    EXPECT_EQ(presenter.get_value("p1", "seg", 1), "42");
+
+    presenter.delete_program("p2");
+    presenter.add_program("p2", "test.cpp", 1024);
+    EXPECT_EQ(presenter.get_type("p2", "seg"), DataType::Unknown);
+    EXPECT_EQ(presenter.get_type("p1", "seg"), DataType::LongLong);
+}
@@ -2,6 +2,7 @@
 #include <Memory/Program.hpp>
 #include <Memory/Manager.hpp>
 #include <Memory/VariableDescriptor.hpp>
+#include <string>
 
 using namespace MemoryNameSpace;
 
@@ -11,9 +12,15 @@ protected:
     Program* program;
     
     void SetUp() override {
-        manager = Manager<1024>();
+        // The threshold is shared by all programs, so every test starts
+        // from and leaves behind the default.
+        Program::set_parallel_threshold(USED_MEMORY_PARALLEL_THRESHOLD);
         program = manager.add_program("test_program", "test.cpp", 512);
     }
+
+    void TearDown() override {
+        Program::set_parallel_threshold(USED_MEMORY_PARALLEL_THRESHOLD);
+    }
 };
 
 TEST_F(ProgramTest, Construction) {
@@ -73,8 +80,49 @@ TEST_F(ProgramTest, ProgramDestructor) {
         Manager<1024> localManager;
         Program* localProg = localManager.add_program("local", "local.cpp", 100);
         
-        // Allocate but don't free - should trigger memory leak in destructor
+        // Allocate but don't free - the program destroys what it still owns
         localProg->allocate_element<VariableDescriptor>("leakyVar", 50);
     }
-    // Destructor should have been called and recorded error
-}
\ No newline at end of file
+}
+
+TEST_F(ProgramTest, LookupByStringView) {
+    VariableDescriptor* var = program->allocate_element<VariableDescriptor>("var1", sizeof(int));
+    ASSERT_NE(var, nullptr);
+    
+    EXPECT_EQ(program->get_name_hash(), hash_name("test_program"));
+    EXPECT_EQ(var->get_name_hash(), hash_name("var1"));
+    
+    const auto& elements = program->get_memory_elements();
+    EXPECT_NE(elements.find(std::string_view{"var1"}), elements.end());
+    EXPECT_NE(elements.find(HashedName{"var1", var->get_name_hash()}), elements.end());
+    EXPECT_EQ(manager.find_element(std::string_view{"test_program"}, std::string_view{"var1"}), var);
+    
+    std::string buffer = "var1 and more";
+    EXPECT_TRUE(program->destroy_element(std::string_view{buffer}.substr(0, 4)));
+    EXPECT_EQ(program->get_used_memory(), 0);
+}
+
+TEST_F(ProgramTest, UsedMemoryStrategiesAgree) {
+    for(size_t i = 0; i < 40; ++i)
+        ASSERT_NE(program->allocate_element<VariableDescriptor>("v" + std::to_string(i), 1 + i % 5), nullptr);
+    ASSERT_NE(program->make_reference("ref", "v0"), nullptr);
+    size_t expected = program->get_used_memory(UsedMemoryStrategy::Serial);
+    EXPECT_EQ(expected, 120);
+    
+    for(UsedMemoryStrategy strategy : {UsedMemoryStrategy::Auto, UsedMemoryStrategy::ParallelStl,
+                                       UsedMemoryStrategy::Threads, UsedMemoryStrategy::Tbb})
+        EXPECT_EQ(program->get_used_memory(strategy), expected);
+}
+
+TEST_F(ProgramTest, ParallelThreshold) {
+    EXPECT_EQ(Program::get_parallel_threshold(), USED_MEMORY_PARALLEL_THRESHOLD);
+    
+    ASSERT_NE(program->allocate_element<VariableDescriptor>("x", 16), nullptr);
+    Program::set_parallel_threshold(0);
+    EXPECT_EQ(program->get_used_memory(), 16);
+    
+    size_t calibrated = Program::calibrate_parallel_threshold();
+    EXPECT_EQ(Program::get_parallel_threshold(), calibrated);
+    EXPECT_GE(calibrated, 1 << 8);
+    EXPECT_EQ(program->get_used_memory(), 16);
+}
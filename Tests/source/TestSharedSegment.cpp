@@ -2,6 +2,9 @@
 #include <Memory/SharedSegmentDescriptor.hpp>
 #include <Memory/Manager.hpp>
 #include <Memory/Program.hpp>
+#include <Memory/VariableDescriptor.hpp>
+#include <atomic>
+#include <vector>
 
 using namespace MemoryNameSpace;
 
@@ -12,7 +15,6 @@ protected:
     Program* program2;
     
     void SetUp() override {
-        manager = Manager<1024>();
         program1 = manager.add_program("prog1", "prog1.cpp", 512);
         program2 = manager.add_program("prog2", "prog2.cpp", 512);
     }
@@ -105,4 +107,83 @@ TEST_F(SharedSegmentTest, AccessThroughManager) {
     // Try to revoke access from non-owner
     bool accessRevoked = manager.revoke_access_to_shared("prog1", "shared");
     EXPECT_TRUE(accessRevoked); // Should fail - prog1 is owner
-}
\ No newline at end of file
+}
+
+TEST_F(SharedSegmentTest, TransformChecksAccessOnce) {
+    SharedSegmentDescriptor* segment =
+        program1->allocate_element<SharedSegmentDescriptor>("shared", 16 * sizeof(int), sizeof(int), program1);
+    ASSERT_TRUE(segment->fill<int>(0, 16, 3));
+    size_t errors = manager.all_errors().size();
+    
+    EXPECT_FALSE(segment->transform<int>("prog2", [](int x){ return x + 1; }));
+    EXPECT_EQ(manager.all_errors().size(), errors + 1);
+    EXPECT_EQ(segment->sum<int>(), 48);
+    
+    segment->insert_program(program2);
+    EXPECT_TRUE(segment->transform<int>("prog2", [](int x){ return x * 2; }));
+    EXPECT_EQ(segment->sum<int>(), 96);
+    segment->erase_program(program2);
+}
+
+TEST(SharedSegmentChunksTest, ParallelChunksCoverSegment) {
+    constexpr size_t capacity = 1 << 20;
+    Manager<capacity> manager;
+    Program* prog = manager.add_program("prog", "prog.cpp", capacity);
+    prog->allocate_element<VariableDescriptor>("pad", 24);
+    const size_t count = 100000;
+    SharedSegmentDescriptor* segment =
+        prog->allocate_element<SharedSegmentDescriptor>("shared", count * sizeof(double), sizeof(double), prog);
+    ASSERT_NE(segment, nullptr);
+    prog->destroy_element("pad");
+    ASSERT_TRUE(segment->fill<double>(0, count, 1.5));
+    
+    std::atomic<size_t> covered{0}, misaligned{0}, chunks{0};
+    const double* first = segment->view<double>().data();
+    EXPECT_TRUE(segment->for_each_chunk<double>("prog", [&](std::span<double> chunk){
+        covered += chunk.size();
+        ++chunks;
+        if(chunk.data() != first && reinterpret_cast<uintptr_t>(chunk.data()) % SharedSegmentDescriptor::CACHE_LINE != 0)
+            ++misaligned;
+    }));
+    EXPECT_EQ(covered, count);
+    EXPECT_EQ(misaligned, 0);
+    EXPECT_GT(chunks, 1);
+    
+    EXPECT_TRUE(segment->transform<double>("prog", [](double x){ return x * 2 - 1; }));
+    EXPECT_EQ(segment->sum<double>(), 2.0 * count);
+    EXPECT_EQ(segment->count_if<double>(Compare::Equal, 2.0), count);
+}
+
+TEST(ProgramSetTest, InsertEraseAndIterate) {
+    ProgramSet set;
+    EXPECT_TRUE(set.empty());
+    
+    EXPECT_TRUE(set.insert(3));
+    EXPECT_FALSE(set.insert(3));
+    EXPECT_TRUE(set.insert(63));
+    EXPECT_TRUE(set.insert(200));
+    EXPECT_EQ(set.size(), 3);
+    EXPECT_TRUE(set.contains(200));
+    EXPECT_FALSE(set.contains(64));
+    EXPECT_FALSE(set.contains(100000));
+    
+    std::vector<ProgramId> ids;
+    set.for_each([&ids](ProgramId id){ ids.push_back(id); });
+    EXPECT_EQ(ids, (std::vector<ProgramId>{3, 63, 200}));
+    
+    EXPECT_TRUE(set.erase(200));
+    EXPECT_FALSE(set.erase(200));
+    EXPECT_FALSE(set.erase(5000));
+    EXPECT_EQ(set.size(), 2);
+}
+
+TEST_F(SharedSegmentTest, AccessById) {
+    SharedSegmentDescriptor* segment = program1->allocate_element<SharedSegmentDescriptor>("shared", 100, sizeof(int), program1);
+    
+    EXPECT_TRUE(segment->check_access(program1->get_id()));
+    EXPECT_FALSE(segment->check_access(program2->get_id()));
+    EXPECT_FALSE(segment->check_access("missing"));
+    EXPECT_TRUE(manager.get_access_to_shared("prog2", "shared"));
+    EXPECT_TRUE(segment->check_access(program2->get_id()));
+    EXPECT_EQ(segment->get_programs().size(), 2);
+}
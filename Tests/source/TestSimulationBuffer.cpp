@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <Memory/SimulationBuffer.hpp>
+#include <Memory/Manager.hpp>
+#include <Memory/Program.hpp>
+#include <Memory/VariableDescriptor.hpp>
+#include <Memory/ArrayDescriptor.hpp>
+#include <memory>
+#include <string>
+
+using namespace MemoryNameSpace;
+
+namespace{
+
+constexpr size_t GIB = size_t{1} << 30;
+
+/**
+ * @brief Leaves free holes of 100, 50 and 200 bytes followed by the free tail
+ */
+void make_holes(SimulationBuffer& buffer){
+    for(size_t size : {100, 8, 50, 8, 200, 8}) buffer.allocate_block(size);
+    buffer.destroy_block(0, 100);
+    buffer.destroy_block(108, 50);
+    buffer.destroy_block(166, 200);
+}
+
+}
+
+TEST(SimulationBufferTest, TracksBlocksWithoutStorage) {
+    SimulationBuffer buffer(64 * GIB);
+    EXPECT_EQ(buffer.get_data(), nullptr);
+    EXPECT_EQ(buffer.get_capacity(), 64 * GIB);
+    EXPECT_EQ(buffer.get_policy(), AllocatorPolicy::FirstFit);
+
+    size_t first = buffer.allocate_block(GIB);
+    size_t second = buffer.allocate_block(2 * GIB);
+    size_t third = buffer.allocate_block(GIB);
+    EXPECT_EQ(first, 0);
+    EXPECT_EQ(second, GIB);
+    EXPECT_EQ(third, 3 * GIB);
+    EXPECT_EQ(buffer.get_free_memory(), 60 * GIB);
+
+    buffer.destroy_block(second, 2 * GIB);
+    EXPECT_EQ(buffer.get_free_block_count(), 2);
+    EXPECT_EQ(buffer.get_largest_free_block(), 60 * GIB);
+    buffer.destroy_block(first, GIB);
+    buffer.destroy_block(third, GIB);
+    ASSERT_EQ(buffer.get_blocks().size(), 1);
+    EXPECT_EQ(buffer.get_blocks()[0].offset, 0);
+    EXPECT_EQ(buffer.get_blocks()[0].size, 64 * GIB);
+    EXPECT_EQ(buffer.get_free_memory(), 64 * GIB);
+}
+
+TEST(SimulationBufferTest, ReportsInvalidOperations) {
+    SimulationBuffer buffer(1024);
+    size_t offset = buffer.allocate_block(100);
+    buffer.allocate_block(100);
+
+    EXPECT_EQ(buffer.try_allocate_block(2000).error(), BufferError::Overflow);
+    EXPECT_EQ(buffer.try_destroy_block(1000, 100).error(), BufferError::OutOfRange);
+    buffer.destroy_block(offset, 100);
+    EXPECT_EQ(buffer.try_destroy_block(offset, 100).error(), BufferError::DoubleFree);
+    EXPECT_EQ(buffer.try_destroy_block(150, 100).error(), BufferError::DoubleFree);
+    EXPECT_THROW(buffer.allocate_block(1024), std::runtime_error);
+
+    buffer.compact(100);
+    ASSERT_EQ(buffer.get_blocks().size(), 1);
+    EXPECT_EQ(buffer.get_blocks()[0].offset, 100);
+    EXPECT_EQ(buffer.get_free_memory(), 924);
+}
+
+TEST(SimulationBufferTest, PoliciesChooseBlocks) {
+    SimulationBuffer first_fit(1024, AllocatorPolicy::FirstFit);
+    SimulationBuffer best_fit(1024, AllocatorPolicy::BestFit);
+    SimulationBuffer worst_fit(1024, AllocatorPolicy::WorstFit);
+    for(SimulationBuffer* buffer : {&first_fit, &best_fit, &worst_fit}) make_holes(*buffer);
+
+    EXPECT_EQ(first_fit.allocate_block(40), 0);
+    EXPECT_EQ(best_fit.allocate_block(40), 108);
+    EXPECT_EQ(worst_fit.allocate_block(40), 374);
+    EXPECT_EQ(best_fit.allocate_block(60), 0);
+    EXPECT_EQ(best_fit.allocate_block(150), 166);
+    EXPECT_EQ(best_fit.get_largest_free_block(), 1024 - 374);
+}
+
+TEST(SimulationBufferTest, ActsAsManagerBuffer) {
+    Manager<0> manager(std::make_unique<SimulationBuffer>(64 * GIB, AllocatorPolicy::BestFit));
+    EXPECT_EQ(manager.get_capacity(), 64 * GIB);
+    Program* program = manager.add_program("planner", "plan.cpp", 64 * GIB);
+    ASSERT_NE(program, nullptr);
+
+    for(size_t i = 0; i < 16; ++i)
+        ASSERT_NE(program->allocate_element<VariableDescriptor>("v" + std::to_string(i), 4 * GIB), nullptr);
+    EXPECT_EQ(program->allocate_element<VariableDescriptor>("extra", 1), nullptr);
+    for(size_t i = 0; i < 16; i += 2) program->destroy_element("v" + std::to_string(i));
+
+    MemoryStats stats = manager.get_stats();
+    EXPECT_EQ(stats.used, 32 * GIB);
+    EXPECT_EQ(stats.free_blocks, 8);
+    EXPECT_EQ(stats.largest_free_block, 4 * GIB);
+    EXPECT_GT(stats.fragmentation(), 0.8);
+
+    manager.defragment_memory();
+    stats = manager.get_stats();
+    EXPECT_EQ(stats.free_blocks, 1);
+    EXPECT_EQ(stats.largest_free_block, 32 * GIB);
+    EXPECT_EQ(stats.moved_bytes, 32 * GIB);
+    EXPECT_EQ(stats.fragmentation(), 0.0);
+    EXPECT_EQ(manager.find_element("planner", "v1")->get_offset(), 0);
+}
+
+TEST(SimulationBufferTest, AlignsBlocksUnderEveryPolicy) {
+    for(AllocatorPolicy policy : {AllocatorPolicy::FirstFit, AllocatorPolicy::BestFit, AllocatorPolicy::WorstFit}){
+        SimulationBuffer buffer(100, policy);
+        buffer.allocate_block(1);
+        EXPECT_EQ(buffer.allocate_block(8, 8), 8);
+        EXPECT_EQ(buffer.get_free_memory(), 91);
+        EXPECT_EQ(buffer.get_free_block_count(), 2);
+    }
+
+    SimulationBuffer buffer(100, AllocatorPolicy::BestFit);
+    buffer.allocate_block(1);
+    buffer.allocate_block(8, 8);
+    EXPECT_EQ(buffer.allocate_block(7), 1);
+    EXPECT_EQ(buffer.get_free_block_count(), 1);
+    EXPECT_EQ(buffer.allocate_block(4), 16);
+    EXPECT_EQ(buffer.try_allocate_block(80, 16).error(), BufferError::Overflow);
+    EXPECT_EQ(buffer.allocate_block(64, 16), 32);
+}
+
+TEST(SimulationBufferTest, ElementDataAccessThrows) {
+    Manager<0> manager(std::make_unique<SimulationBuffer>(GIB));
+    Program* program = manager.add_program("planner", "plan.cpp", GIB);
+    VariableDescriptor* var = program->allocate_element<VariableDescriptor>("v", sizeof(int));
+    ArrayDescriptor* arr = program->allocate_element<ArrayDescriptor>("a", 4 * sizeof(int), sizeof(int));
+    ASSERT_NE(var, nullptr);
+    ASSERT_NE(arr, nullptr);
+
+    int value = 0;
+    EXPECT_THROW(var->set_value(1), std::runtime_error);
+    EXPECT_THROW(var->get_value(value), std::runtime_error);
+    EXPECT_THROW(var->get_field<int>(0), std::runtime_error);
+    int values[4] = {};
+    EXPECT_THROW(arr->read_range<int>(0, values), std::runtime_error);
+    EXPECT_THROW(arr->get_value(value, 1), std::runtime_error);
+    EXPECT_THROW(arr->sum<int>(), std::runtime_error);
+    EXPECT_THROW(arr->view<int>(), std::runtime_error);
+
+    // Metadata-only operations keep working.
+    EXPECT_EQ(manager.get_stats().used, sizeof(int) + 4 * sizeof(int));
+    EXPECT_TRUE(program->destroy_element("v"));
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <Memory/SystemReport.hpp>
+#include <Memory/Manager.hpp>
+#include <Memory/Program.hpp>
+#include <Memory/VariableDescriptor.hpp>
+#include <Memory/ArrayDescriptor.hpp>
+#include <Memory/SharedSegmentDescriptor.hpp>
+#include <string>
+
+using namespace MemoryNameSpace;
+
+namespace{
+
+size_t kind_index(ElementKind kind){
+    return static_cast<size_t>(kind);
+}
+
+}
+
+class SystemReportTest : public ::testing::Test {
+protected:
+    Manager<1024> manager;
+    Program* prog1 = nullptr;
+    Program* prog2 = nullptr;
+    
+    void SetUp() override {
+        prog1 = manager.add_program("prog1", "test.cpp", 1024);
+        prog2 = manager.add_program("prog2", "test.cpp", 1024);
+        prog1->allocate_element<VariableDescriptor>("a", 16);
+        prog1->allocate_element<ArrayDescriptor>("arr", 10 * sizeof(int), sizeof(int));
+        prog1->allocate_element<VariableDescriptor>("b", 8);
+        prog2->allocate_element<VariableDescriptor>("c", 32);
+        prog1->allocate_element<SharedSegmentDescriptor>("seg", 64, sizeof(int), prog1);
+        manager.get_access_to_shared("prog2", "seg");
+        prog2->make_reference("ref", "c");
+        prog1->make_reference("ref_b", "b");
+        prog1->destroy_element("b");
+        prog1->destroy_element("a");
+    }
+};
+
+TEST_F(SystemReportTest, CollectsUsageFanOutAndFragmentation) {
+    SystemReport report = make_system_report(manager);
+    EXPECT_FALSE(report.parallel);
+    
+    ASSERT_EQ(report.program_usage.size(), 2);
+    EXPECT_EQ(report.program_usage[prog1->get_id()], 40 + 64);
+    EXPECT_EQ(report.program_usage[prog2->get_id()], 32 + 64);
+    MemoryStats stats = manager.get_stats();
+    EXPECT_EQ(report.program_usage[0], stats.usage(0));
+    EXPECT_EQ(report.program_usage[1], stats.usage(1));
+    
+    EXPECT_EQ(report.kind_count[kind_index(ElementKind::Variable)], 1);
+    EXPECT_EQ(report.kind_count[kind_index(ElementKind::Array)], 1);
+    EXPECT_EQ(report.kind_count[kind_index(ElementKind::Shared)], 1);
+    EXPECT_EQ(report.kind_count[kind_index(ElementKind::Reference)], 2);
+    EXPECT_EQ(report.kind_usage[kind_index(ElementKind::Array)], 40);
+    EXPECT_EQ(report.used, 136);
+    
+    ASSERT_EQ(report.segments.size(), 1);
+    EXPECT_EQ(report.segments[0].size, 64);
+    EXPECT_EQ(report.segments[0].programs, 2);
+    EXPECT_EQ(report.dangling_references, 1);
+    
+    // Free blocks: [0, 16), [56, 64) and [160, 1024).
+    EXPECT_EQ(report.free, 1024 - 136);
+    EXPECT_EQ(report.largest_free_block, 1024 - 160);
+    EXPECT_EQ(report.free_block_histogram[4], 1);
+    EXPECT_EQ(report.free_block_histogram[3], 1);
+    EXPECT_EQ(report.free_block_histogram[9], 1);
+    EXPECT_EQ(report.errors_total[ACCESS_ERROR], 0);
+}
+
+TEST_F(SystemReportTest, ParallelPassMatchesSerialPass) {
+    Manager<1 << 20> large;
+    Program* prog = large.add_program("prog", "test.cpp", 1 << 20);
+    Program* other = large.add_program("other", "test.cpp", 1 << 20);
+    for(size_t i = 0; i < 20000; ++i)
+        prog->allocate_element<VariableDescriptor>("v" + std::to_string(i), 1 + i % 7);
+    for(size_t i = 0; i < 20000; i += 3)
+        prog->destroy_element("v" + std::to_string(i));
+    other->allocate_element<SharedSegmentDescriptor>("seg", 128, sizeof(int), other);
+    large.get_access_to_shared("prog", "seg");
+    other->destroy_element("missing");
+    
+    SystemReport serial = make_system_report(large, SIZE_MAX);
+    SystemReport parallel = make_system_report(large, 0);
+    EXPECT_FALSE(serial.parallel);
+    
+    EXPECT_EQ(parallel.program_usage, serial.program_usage);
+    EXPECT_EQ(parallel.kind_usage, serial.kind_usage);
+    EXPECT_EQ(parallel.kind_count, serial.kind_count);
+    ASSERT_EQ(parallel.segments.size(), serial.segments.size());
+    EXPECT_EQ(parallel.segments[0].programs, 2);
+    EXPECT_EQ(parallel.free_block_histogram, serial.free_block_histogram);
+    EXPECT_EQ(parallel.free, serial.free);
+    EXPECT_EQ(parallel.largest_free_block, serial.largest_free_block);
+    EXPECT_EQ(parallel.errors, serial.errors);
+    EXPECT_EQ(serial.used + serial.free, size_t{1} << 20);
+    EXPECT_EQ(serial.program_usage[prog->get_id()], large.get_stats().usage(prog->get_id()));
+    EXPECT_EQ(serial.errors[ACCESS_ERROR], 1);
+}
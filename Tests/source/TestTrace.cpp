@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <Memory/Trace.hpp>
+#include <Memory/Manager.hpp>
+#include <Memory/Program.hpp>
+#include <Memory/VariableDescriptor.hpp>
+#include <Memory/ArrayDescriptor.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace MemoryNameSpace;
+
+namespace{
+
+std::vector<TraceEvent> sample_events(){
+    return {
+        TraceEvent{10, 64, 0, 0, TraceOp::Allocate, ElementKind::Variable},
+        TraceEvent{20, 300, 1, 2, TraceOp::Allocate, ElementKind::Array},
+        TraceEvent{25, 128, 0, 0, TraceOp::Resize, ElementKind::Variable},
+        TraceEvent{40, 0, 0, 0, TraceOp::Defragment, ElementKind::Variable},
+        TraceEvent{1 << 20, 0, 1, 2, TraceOp::Free, ElementKind::Variable},
+        TraceEvent{(1 << 20) + 1, 0, 0, 0, TraceOp::Free, ElementKind::Variable},
+    };
+}
+
+}
+
+TEST(TraceFormatTest, RoundTripsEvents) {
+    std::vector<TraceEvent> events = sample_events();
+    std::stringstream stream;
+    write_trace(stream, events);
+
+    auto read = read_trace(stream);
+    ASSERT_TRUE(read.has_value());
+    ASSERT_EQ(read->size(), events.size());
+    for(size_t i = 0; i < events.size(); ++i){
+        EXPECT_EQ((*read)[i].timestamp, events[i].timestamp);
+        EXPECT_EQ((*read)[i].size, events[i].size);
+        EXPECT_EQ((*read)[i].element, events[i].element);
+        EXPECT_EQ((*read)[i].program, events[i].program);
+        EXPECT_EQ((*read)[i].op, events[i].op);
+        EXPECT_EQ((*read)[i].kind, events[i].kind);
+    }
+}
+
+TEST(TraceFormatTest, RejectsInvalidStreams) {
+    std::stringstream garbage("NOPE");
+    auto bad_magic = read_trace(garbage);
+    ASSERT_FALSE(bad_magic.has_value());
+    EXPECT_EQ(bad_magic.error(), TraceError::BadMagic);
+
+    std::stringstream full;
+    write_trace(full, sample_events());
+    std::string bytes = full.str();
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+    auto cut = read_trace(truncated);
+    ASSERT_FALSE(cut.has_value());
+    EXPECT_EQ(cut.error(), TraceError::Truncated);
+
+    bytes[4] = 2;
+    std::stringstream newer(bytes);
+    auto version = read_trace(newer);
+    ASSERT_FALSE(version.has_value());
+    EXPECT_EQ(version.error(), TraceError::UnsupportedVersion);
+}
+
+TEST(TraceRecorderTest, RecordsProgramOperations) {
+    Manager<1024> manager;
+    Program* program = manager.add_program("prog", "test.cpp", 1024);
+    program->allocate_element<VariableDescriptor>("before", 8);
+
+    TraceRecorder recorder;
+    manager.set_trace_recorder(&recorder);
+    EXPECT_EQ(manager.get_trace_recorder(), &recorder);
+    program->allocate_element<VariableDescriptor>("x", 16);
+    program->allocate_element<ArrayDescriptor>("arr", 40, sizeof(int));
+    program->make_reference("ref", "x");
+    program->destroy_element("x");
+    program->destroy_element("before");
+    program->destroy_element("missing");
+    manager.defragment_memory();
+    manager.set_trace_recorder(nullptr);
+    program->destroy_element("arr");
+
+    const std::vector<TraceEvent>& events = recorder.get_events();
+    ASSERT_EQ(events.size(), 4);
+    EXPECT_EQ(events[0].op, TraceOp::Allocate);
+    EXPECT_EQ(events[0].size, 16);
+    EXPECT_EQ(events[0].kind, ElementKind::Variable);
+    EXPECT_EQ(events[0].program, program->get_id());
+    EXPECT_EQ(events[1].op, TraceOp::Allocate);
+    EXPECT_EQ(events[1].kind, ElementKind::Array);
+    EXPECT_NE(events[1].element, events[0].element);
+    EXPECT_EQ(events[2].op, TraceOp::Free);
+    EXPECT_EQ(events[2].element, events[0].element);
+    EXPECT_EQ(events[3].op, TraceOp::Defragment);
+    EXPECT_LE(events[0].timestamp, events[3].timestamp);
+}
+
+TEST(TraceGeneratorTest, IsDeterministicAndBalanced) {
+    TraceWorkload workload;
+    workload.allocations = 2000;
+    workload.programs = 3;
+    workload.defragment_every = 500;
+    std::vector<TraceEvent> events = generate_trace(workload);
+    std::vector<TraceEvent> again = generate_trace(workload);
+    ASSERT_EQ(events.size(), again.size());
+
+    std::vector<int> live(workload.allocations, 0);
+    size_t defragments = 0;
+    uint64_t previous = 0;
+    for(size_t i = 0; i < events.size(); ++i){
+        EXPECT_EQ(events[i].size, again[i].size);
+        EXPECT_GE(events[i].timestamp, previous);
+        previous = events[i].timestamp;
+        if(events[i].op == TraceOp::Defragment){
+            ++defragments;
+            continue;
+        }
+        ASSERT_LT(events[i].element, live.size());
+        EXPECT_LT(events[i].program, workload.programs);
+        if(events[i].op == TraceOp::Allocate){
+            EXPECT_GE(events[i].size, 1);
+            EXPECT_LE(events[i].size, workload.max_size);
+            EXPECT_EQ(live[events[i].element]++, 0);
+        }
+        else EXPECT_EQ(live[events[i].element]--, 1);
+    }
+    EXPECT_EQ(defragments, 4);
+    for(int count : live) EXPECT_EQ(count, 0);
+}
+
+TEST(TraceReplayTest, ReplaysAgainstBuffer) {
+    TraceWorkload workload;
+    workload.allocations = 2000;
+    workload.defragment_every = 700;
+    std::vector<TraceEvent> events = generate_trace(workload);
+    auto buffer = std::make_unique<Buffer<1 << 22>>();
+
+    ReplayResult result = replay_trace(events, *buffer);
+    EXPECT_EQ(result.events, events.size());
+    EXPECT_EQ(result.failed, 0);
+    EXPECT_EQ(result.allocate.count, workload.allocations);
+    EXPECT_EQ(result.free.count, workload.allocations);
+    EXPECT_EQ(result.defragment.count, 2);
+    EXPECT_LE(result.allocate.p50, result.allocate.p99);
+    EXPECT_LE(result.allocate.p99, result.allocate.max);
+    EXPECT_GT(result.peak_used, 0);
+    EXPECT_GE(result.peak_fragmentation, 0.0);
+    EXPECT_LT(result.peak_fragmentation, 1.0);
+    EXPECT_EQ(buffer->get_free_memory(), buffer->get_capacity());
+}
+
+TEST(TraceReplayTest, ReplaysAgainstManagerAndFlagsFailures) {
+    std::vector<TraceEvent> events = sample_events();
+    events.push_back(TraceEvent{1 << 21, 4096, 2, 0, TraceOp::Allocate, ElementKind::Variable});
+    events.push_back(TraceEvent{(1 << 21) + 1, 0, 2, 0, TraceOp::Free, ElementKind::Variable});
+    Manager<1024> manager;
+
+    ReplayResult result = replay_trace(events, manager);
+    EXPECT_EQ(result.events, events.size());
+    EXPECT_EQ(result.failed, 2);
+    EXPECT_EQ(result.peak_used, 300 + 128);
+    EXPECT_EQ(result.defragment.count, 1);
+    EXPECT_NE(manager.find_program("trace_0"), nullptr);
+    EXPECT_NE(manager.find_program("trace_2"), nullptr);
+    EXPECT_EQ(manager.find_program("trace_1"), nullptr);
+    EXPECT_EQ(manager.get_stats().used, 0);
+}